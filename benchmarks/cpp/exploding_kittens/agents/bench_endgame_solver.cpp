@@ -0,0 +1,37 @@
+#include <benchmark/benchmark.h>
+
+#include "exploding_kittens/agents/endgame_solver.h"
+#include "exploding_kittens/environment/rules.h"
+
+namespace exploding_kittens {
+
+// Solving 2 player endgames from scratch (empty table), with at most
+// range(0) cards in the deck. The endgames come from random games.
+static void BM_EndgameSolve(benchmark::State &state) {
+    EndgameSolver solver(EndgameConfig{static_cast<size_t>(state.range(0))});
+    GameState g;
+    g.seed(9);
+    ActionList legal;
+    for (auto _ : state) {
+        state.PauseTiming();
+        do {
+            g.reset(2);
+            while (g.state != State::Game_Over and
+                   g.cards.deck.size() > solver.config().max_deck_size) {
+                legal.clear();
+                Rules::append_legal_actions(g, legal);
+                Rules::take_action(g, legal[g.rng.below(legal.size())]);
+            }
+        } while (g.state == State::Game_Over);
+        solver.clear();
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(solver.solve(g));
+    }
+    state.counters["nodes"] = benchmark::Counter(
+        solver.nodes(), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_EndgameSolve)->ArgName("deck")->Arg(6)->Arg(8)->Arg(10)
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace exploding_kittens
\ No newline at end of file
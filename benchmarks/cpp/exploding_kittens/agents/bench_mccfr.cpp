@@ -0,0 +1,19 @@
+#include <benchmark/benchmark.h>
+
+#include "exploding_kittens/agents/mccfr.h"
+
+namespace exploding_kittens {
+
+// MCCFR iterations over full 2 player games, on range(0) threads.
+static void BM_MccfrIterations(benchmark::State &state) {
+    Mccfr mccfr(MccfrConfig{2, static_cast<size_t>(state.range(0)), 1 << 28});
+    for (auto _ : state)
+        mccfr.run(64);
+    state.counters["iterations/s"] = benchmark::Counter(
+        mccfr.iterations(), benchmark::Counter::kIsRate);
+    state.counters["infosets"] = mccfr.table().size();
+}
+BENCHMARK(BM_MccfrIterations)->ArgName("threads")->Arg(1)->Arg(4)
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+} // namespace exploding_kittens
\ No newline at end of file
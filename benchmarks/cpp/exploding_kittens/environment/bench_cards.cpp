@@ -0,0 +1,65 @@
+#include <benchmark/benchmark.h>
+
+#include "exploding_kittens/environment/cards.h"
+
+namespace exploding_kittens {
+
+// Dealing a fresh game: filling the deck, dealing hands, shuffling.
+static void BM_CardsReset(benchmark::State &state) {
+    Cards cards;
+    tabletop_general::Rng rng(1);
+    for (auto _ : state) {
+        cards.reset(state.range(0), rng);
+        benchmark::DoNotOptimize(cards);
+    }
+}
+BENCHMARK(BM_CardsReset)->DenseRange(MIN_PLAYERS, MAX_PLAYERS);
+
+static void BM_CardStackShuffle(benchmark::State &state) {
+    Cards cards;
+    tabletop_general::Rng rng(2);
+    cards.reset(MAX_PLAYERS, rng);
+    for (auto _ : state) {
+        cards.deck.shuffle(rng);
+        benchmark::ClobberMemory();
+    }
+    state.counters["deck_size"] = cards.deck.size();
+}
+BENCHMARK(BM_CardStackShuffle);
+
+// Pops the top card and puts it back at a given depth (like a defuse does).
+static void BM_CardStackPopInsert(benchmark::State &state) {
+    Cards cards;
+    tabletop_general::Rng rng(3);
+    cards.reset(MAX_PLAYERS, rng);
+    size_t depth = state.range(0);
+    for (auto _ : state) {
+        CardIdx c = cards.deck.pop();
+        cards.deck.insert(c, depth);
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_CardStackPopInsert)->Arg(0)->Arg(16)->Arg(MAX_CARDS);
+
+namespace {
+
+// Exposes the protected random_card, which is normally used through the
+// hands (e.g. for stealing a random card).
+struct BenchCollection: public CardCollection {
+    using CardCollection::random_card;
+};
+
+} // namespace
+
+static void BM_CardCollectionRandomCard(benchmark::State &state) {
+    Cards cards;
+    tabletop_general::Rng rng(4);
+    cards.reset(MAX_PLAYERS, rng);
+    BenchCollection collection;
+    std::copy_n(cards.deck.counts(), UNIQUE_CARDS, collection.counts());
+    for (auto _ : state)
+        benchmark::DoNotOptimize(collection.random_card(rng));
+}
+BENCHMARK(BM_CardCollectionRandomCard);
+
+} // namespace exploding_kittens
\ No newline at end of file
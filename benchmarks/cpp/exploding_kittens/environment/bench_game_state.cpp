@@ -0,0 +1,118 @@
+#include <benchmark/benchmark.h>
+
+#include "exploding_kittens/environment/game_state.h"
+#include "exploding_kittens/environment/vector_game_state.h"
+#include "exploding_kittens/environment/rules.h"
+#include "exploding_kittens/environment/actions/draw_card.h"
+#include "exploding_kittens/environment/actions/play_defuse.h"
+#include "exploding_kittens/environment/actions/play_nope.h"
+#include "exploding_kittens/environment/actions/skip_nope.h"
+
+namespace exploding_kittens {
+
+static void BM_GameStateHash(benchmark::State &state) {
+    GameState g;
+    g.seed(1);
+    g.reset(state.range(0));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(g.hash());
+}
+BENCHMARK(BM_GameStateHash)->Arg(MIN_PLAYERS)->Arg(MAX_PLAYERS);
+
+// Puts g in the state in which actions of type T can be legal. The card
+// counts are not kept consistent: only legal action generation gets run.
+template <typename T>
+static void enter_state(GameState &g) {
+    if constexpr (std::is_same_v<T, PlayDefuse>)
+        g.state = State::Defuse;
+    else if constexpr (std::is_same_v<T, PlayNope> or
+                       std::is_same_v<T, SkipNope>) {
+        g.state = State::Nope;
+        g.secondary_players.assign(1, 1);
+        g.cards.hands[1].counts()[to_uint(CardIdx::Nope)] = 1U;
+    }
+}
+
+template <typename T>
+static void BM_LegalActions(benchmark::State &state) {
+    GameState g;
+    g.seed(2);
+    g.reset(MAX_PLAYERS);
+    enter_state<T>(g);
+
+    T action_type(g);
+    ActionList list;
+    for (auto _ : state) {
+        list.clear();
+        action_type.append_legal_actions(list);
+        benchmark::DoNotOptimize(list);
+    }
+    state.counters["actions"] = list.size();
+}
+BENCHMARK(BM_LegalActions<DrawCard>);
+BENCHMARK(BM_LegalActions<PlayDefuse>);
+BENCHMARK(BM_LegalActions<PlayNope>);
+BENCHMARK(BM_LegalActions<SkipNope>);
+
+// Complete games with uniformly random actions, through Rules. The second
+// argument selects a lazy deck.
+static void BM_RandomPlay(benchmark::State &state) {
+    GameState g;
+    g.seed(3);
+    g.cards.deck.set_lazy(state.range(1) != 0);
+    ActionList legal;
+    size_t steps = 0;
+    for (auto _ : state) {
+        g.reset(state.range(0));
+        while (g.state != State::Game_Over) {
+            legal.clear();
+            Rules::append_legal_actions(g, legal);
+            Rules::take_action(g, legal[g.rng.below(legal.size())]);
+            ++steps;
+        }
+    }
+    state.counters["games/s"] = benchmark::Counter(
+        state.iterations(), benchmark::Counter::kIsRate);
+    state.counters["steps/s"] = benchmark::Counter(
+        steps, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_RandomPlay)->ArgNames({"players", "lazy"})
+    ->ArgsProduct({benchmark::CreateDenseRange(MIN_PLAYERS, MAX_PLAYERS, 1),
+                   {0, 1}});
+
+// Taking an action and taking it back, versus saving and restoring a
+// snapshot around it (argument 1).
+static void BM_MakeUndo(benchmark::State &state) {
+    GameState g;
+    g.seed(5);
+    g.reset(MAX_PLAYERS);
+    Action draw{ActionEnum::Draw, {}, 0, 0};
+    GameStateSnapshot snap;
+    for (auto _ : state) {
+        if (state.range(0) == 0) {
+            UndoRecord undo = Rules::make_action(g, draw);
+            Rules::undo_action(g, undo);
+        } else {
+            g.save(snap);
+            Rules::take_action(g, draw);
+            g.restore(snap);
+        }
+        benchmark::DoNotOptimize(g.turns_left);
+    }
+}
+BENCHMARK(BM_MakeUndo)->ArgName("snapshot")->Arg(0)->Arg(1);
+
+// Observations of the acting players of a batch of games, as floats.
+static void BM_Observations(benchmark::State &state) {
+    VectorGameState games(state.range(0), MAX_PLAYERS, 4);
+    std::vector<float> obs(games.size() * OBS_SIZE);
+    for (auto _ : state) {
+        games.observations(obs);
+        benchmark::DoNotOptimize(obs.data());
+    }
+    state.counters["obs/s"] = benchmark::Counter(
+        state.iterations() * games.size(), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_Observations)->Arg(1)->Arg(256);
+
+} // namespace exploding_kittens
\ No newline at end of file
@@ -0,0 +1,145 @@
+// Python bindings of the C++ core. The batched environment owns NumPy
+// buffers for all its outputs, which the C++ code writes into directly: a step
+// creates no Python objects and copies nothing but the action codes.
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+#include "exploding_kittens/environment/batch_environment.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace py = pybind11;
+
+namespace exploding_kittens {
+
+namespace {
+
+template <typename T>
+using Array = py::array_t<T, py::array::c_style>;
+
+template <typename T>
+std::span<T> view(Array<T> &array) {
+    return std::span<T>(array.mutable_data(), array.size());
+}
+
+class PyBatchEnvironment {
+
+    BatchEnvironment d_env;
+    std::vector<ActionCode> d_codes;
+
+    // The output buffers, shared with Python:
+    Array<float> d_observations;
+    Array<float> d_rewards;
+    Array<uint8_t> d_dones;
+    Array<uint8_t> d_agents;
+    Array<uint8_t> d_masks;
+
+    public:
+        PyBatchEnvironment(size_t num_games, size_t num_players,
+                           uint64_t seed, bool auto_reset)
+        :
+            d_env(num_games, num_players, seed, auto_reset),
+            d_codes(num_games),
+            d_observations(std::vector<size_t>{num_games, OBS_SIZE}),
+            d_rewards(std::vector<size_t>{num_games, num_players}),
+            d_dones(static_cast<py::ssize_t>(num_games)),
+            d_agents(static_cast<py::ssize_t>(num_games)),
+            d_masks(std::vector<size_t>{num_games, NUM_ACTION_CODES})
+        {}
+
+        void reset() {
+            BatchOutputs out = outputs();
+            py::gil_scoped_release release;
+            d_env.reset(out);
+        }
+
+        void step(py::array_t<int64_t, py::array::c_style |
+                                       py::array::forcecast> const &actions) {
+            if (static_cast<size_t>(actions.size()) != d_env.size())
+                throw std::invalid_argument("Need exactly one action per "
+                                            "game.");
+            int64_t const *codes = actions.data();
+            for (size_t idx = 0; idx != d_codes.size(); ++idx) {
+                if (codes[idx] < 0 or
+                        static_cast<size_t>(codes[idx]) >= NUM_ACTION_CODES)
+                    throw std::out_of_range("Invalid action code.");
+                d_codes[idx] = static_cast<ActionCode>(codes[idx]);
+            }
+
+            BatchOutputs out = outputs();
+            py::gil_scoped_release release;
+            d_env.step(d_codes, out);
+        }
+
+        // The view of any player, in a new array (not for the hot path).
+        Array<float> observe(size_t game, uint8_t player) const {
+            if (game >= d_env.size())
+                throw std::out_of_range("No such game.");
+            Array<float> obs(static_cast<py::ssize_t>(OBS_SIZE));
+            encode_observation<float>(d_env.games()[game], player, view(obs));
+            return obs;
+        }
+
+        size_t size() const { return d_env.size(); }
+        size_t num_players() const { return d_env.num_players(); }
+
+        Array<float> observations() const { return d_observations; }
+        Array<float> rewards() const { return d_rewards; }
+        Array<uint8_t> dones() const { return d_dones; }
+        Array<uint8_t> agents() const { return d_agents; }
+        Array<uint8_t> masks() const { return d_masks; }
+
+    private:
+        BatchOutputs outputs() {
+            return BatchOutputs{view(d_observations), view(d_rewards),
+                view(d_dones), view(d_agents), view(d_masks)};
+        }
+};
+
+} // namespace
+
+} // namespace exploding_kittens
+
+PYBIND11_MODULE(_tabletop_rl, m) {
+    using namespace exploding_kittens;
+
+    m.doc() = "C++ core of tabletop-rl.";
+    m.attr("OBS_SIZE") = OBS_SIZE;
+    m.attr("NUM_ACTION_CODES") = NUM_ACTION_CODES;
+    m.attr("MIN_PLAYERS") = MIN_PLAYERS;
+    m.attr("MAX_PLAYERS") = MAX_PLAYERS;
+
+    py::class_<PyBatchEnvironment>(m, "BatchEnvironment",
+        "A batch of Exploding Kittens games. reset() and step() write into "
+        "the arrays observations, rewards, dones, agents and masks, which "
+        "are allocated once: keep references to them rather than copying. "
+        "With auto_reset, games that end in a step start over right away.")
+        .def(py::init<size_t, size_t, uint64_t, bool>(), py::arg("num_games"),
+             py::arg("num_players"), py::arg("seed") = 0,
+             py::arg("auto_reset") = false)
+        .def("reset", &PyBatchEnvironment::reset,
+             "Start a new game everywhere.")
+        .def("step", &PyBatchEnvironment::step, py::arg("actions"),
+             "Take one action code per game. Finished games ignore theirs. "
+             "Raises ValueError, stepping no game, if an action is illegal.")
+        .def("observe", &PyBatchEnvironment::observe, py::arg("game"),
+             py::arg("player"), "The observation of any player of a game.")
+        .def_property_readonly("size", &PyBatchEnvironment::size)
+        .def_property_readonly("num_players",
+                               &PyBatchEnvironment::num_players)
+        .def_property_readonly("observations",
+                               &PyBatchEnvironment::observations,
+                               "(num_games, OBS_SIZE) float32, for the "
+                               "acting players.")
+        .def_property_readonly("rewards", &PyBatchEnvironment::rewards,
+                               "(num_games, num_players) float32.")
+        .def_property_readonly("dones", &PyBatchEnvironment::dones,
+                               "(num_games,) uint8.")
+        .def_property_readonly("agents", &PyBatchEnvironment::agents,
+                               "(num_games,) uint8, the acting players.")
+        .def_property_readonly("masks", &PyBatchEnvironment::masks,
+                               "(num_games, NUM_ACTION_CODES) uint8.");
+}
\ No newline at end of file
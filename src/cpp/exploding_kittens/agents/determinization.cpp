@@ -0,0 +1,113 @@
+#include "determinization.h"
+
+#include <stdexcept>
+
+namespace exploding_kittens {
+
+Determinizer::Determinizer(GameStateSnapshot const &snap, uint8_t observer,
+                           HandKnowledge const &knowledge)
+:
+    d_base(snap)
+{
+    if (observer >= snap.num_players)
+        throw std::invalid_argument("Observer is not in the game.");
+
+    // The deck: known positions stay, the others go to the pool. The pool
+    // comes from the counts, as a lazy deck has unresolved positions.
+    uint64_t known = snap.deck_known[observer];
+    std::array<uint8_t, UNIQUE_CARDS> unknown = snap.deck_counts;
+    d_base.deck_counts = {};
+    for (uint8_t pos = 0; pos != snap.deck_size; ++pos) {
+        CardIdx card = snap.deck[pos];
+        if (known >> pos & 1) {
+            ++d_base.deck_counts[to_uint(card)];
+            --unknown[to_uint(card)];
+        } else {
+            d_free_slots[d_num_free_slots++] = pos;
+        }
+    }
+    // Kittens only ever go back into the deck, so they are pooled last:
+    uint8_t kittens = unknown[to_uint(CardIdx::Exploding_Kitten)];
+    unknown[to_uint(CardIdx::Exploding_Kitten)] = 0;
+    for (uint8_t i = 0; i != UNIQUE_CARDS; ++i)
+        for (uint8_t n = 0; n != unknown[i]; ++n)
+            d_pool[d_pool_size++] = from_uint(i);
+
+    // Hands of living opponents: known cards stay, the others go.
+    for (uint8_t p = 0; p != snap.num_players; ++p) {
+        auto const &hand = snap.hands[p];
+        bool alive = hand[to_uint(CardIdx::Exploding_Kitten)] == 0 or
+                     hand[to_uint(CardIdx::Defuse)] != 0;
+        if (p == observer or not alive)
+            continue;
+        for (uint8_t i = 0; i != UNIQUE_CARDS; ++i) {
+            // A kitten in hand (to be defused) was drawn face up:
+            uint8_t keep = i == to_uint(CardIdx::Exploding_Kitten) ?
+                hand[i] : knowledge.in_hand[p][i];
+            if (keep > hand[i])
+                throw std::invalid_argument("Knowledge does not agree with "
+                                            "the state.");
+            for (uint8_t n = keep; n != hand[i]; ++n)
+                d_pool[d_pool_size++] = from_uint(i);
+            d_free_in_hand[p] += hand[i] - keep;
+            d_base.hands[p][i] = keep;
+        }
+    }
+    d_num_kittens = kittens;
+    for (uint8_t n = 0; n != kittens; ++n)
+        d_pool[d_pool_size++] = CardIdx::Exploding_Kitten;
+}
+
+void Determinizer::sample(tabletop_general::Rng &rng,
+                          GameStateSnapshot &out) const {
+    out = d_base;
+
+    // Only draw as many cards from the pool as there are free places, with
+    // a partial Fisher-Yates shuffle (on a copy):
+    std::array<CardIdx, MAX_CARDS> pool = d_pool;
+    // The hands draw from the front, which leaves out the kittens at the end.
+    size_t next = 0;
+    auto draw = [&](size_t end) {
+        size_t pick = next + rng.below(end - next);
+        std::swap(pool[next], pool[pick]);
+        return pool[next++];
+    };
+
+    auto fill_hands = [&]() {
+        for (uint8_t p = 0; p != d_base.num_players; ++p)
+            for (uint8_t n = 0; n != d_free_in_hand[p]; ++n)
+                ++out.hands[p][to_uint(draw(d_pool_size - d_num_kittens))];
+    };
+
+    if (d_base.deck_lazy) {
+        // The free slots become unresolved (a resolved one may hold a card
+        // the observer does not know about): the rest of the pool only has
+        // to be counted in.
+        for (uint8_t slot = 0; slot != d_num_free_slots; ++slot)
+            out.deck[d_free_slots[slot]] = CardIdx::Unresolved;
+        fill_hands();
+        for (size_t idx = next; idx != d_pool_size; ++idx)
+            ++out.deck_counts[to_uint(pool[idx])];
+        return;
+    }
+
+    fill_hands();
+    for (uint8_t slot = 0; slot != d_num_free_slots; ++slot) {
+        CardIdx card = draw(d_pool_size);
+        out.deck[d_free_slots[slot]] = card;
+        ++out.deck_counts[to_uint(card)];
+    }
+}
+
+void Determinizer::sample(tabletop_general::Rng &rng,
+                          std::span<GameStateSnapshot> out) const {
+    for (GameStateSnapshot &snap : out)
+        sample(rng, snap);
+}
+
+void determinize(GameStateSnapshot &snap, uint8_t observer,
+                 tabletop_general::Rng &rng) {
+    Determinizer(snap, observer).sample(rng, snap);
+}
+
+} // namespace exploding_kittens
\ No newline at end of file
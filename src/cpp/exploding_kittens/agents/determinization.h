@@ -0,0 +1,81 @@
+#ifndef EK_DETERMINIZATION_H
+#define EK_DETERMINIZATION_H
+
+#include "../environment/game_state_snapshot.h"
+#include "../../utils.h"
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+
+namespace exploding_kittens {
+
+/**
+ * @brief What a player knows about the hands of the others, beyond what is
+ * public. Filled in from the player's observation history, e.g. the card it
+ * gave away for a favor. What it knows of the deck order is not in here: the
+ * deck keeps track of that itself (see CardStack::known_mask).
+ */
+struct HandKnowledge {
+    // Per player: cards known to be in their hand (they may have more).
+    std::array<std::array<uint8_t, UNIQUE_CARDS>, MAX_PLAYERS> in_hand{};
+};
+
+/**
+ * @brief Samples determinizations of an observer's information set: full
+ * game states that agree with everything the observer knows, uniformly among
+ * those. Known are its own hand, the discard pile, the hands of eliminated
+ * players, all stack and hand sizes, the deck cards it knows the position of,
+ * and the cards of HandKnowledge. All other cards are dealt out at random
+ * over the remaining deck positions and hand slots, except the Exploding
+ * Kittens: those can only be in the deck (or, drawn face up, in a hand).
+ *
+ * The constraints are applied directly: the known cards are set aside once
+ * in the constructor, and every sample is one shuffle of the rest. No sample
+ * is ever rejected. With a lazy deck, the unknown deck positions are left
+ * unresolved: only the hands get dealt, the rest is counted into the deck.
+ */
+class Determinizer {
+
+    GameStateSnapshot d_base;       // Only the known cards in hidden places.
+    std::array<CardIdx, MAX_CARDS> d_pool;      // The unknown cards.
+    uint8_t d_pool_size = 0;
+    uint8_t d_num_kittens = 0;      // At the end of d_pool, for the deck.
+    std::array<uint8_t, MAX_CARDS> d_free_slots;    // Unknown deck indices.
+    uint8_t d_num_free_slots = 0;
+    std::array<uint8_t, MAX_PLAYERS> d_free_in_hand{};  // Per player.
+
+    public:
+        /**
+         * @param snap The true state.
+         * @param observer The player whose information set to sample.
+         * @param knowledge What observer knows of the other hands.
+         * @throws std::invalid_argument if observer is not in the game, or
+         * knowledge does not agree with snap.
+         */
+        Determinizer(GameStateSnapshot const &snap, uint8_t observer,
+                     HandKnowledge const &knowledge = HandKnowledge{});
+
+        /**
+         * @brief Write one determinization into out.
+         */
+        void sample(tabletop_general::Rng &rng, GameStateSnapshot &out) const;
+
+        /**
+         * @brief Write a batch of independent determinizations.
+         */
+        void sample(tabletop_general::Rng &rng,
+                    std::span<GameStateSnapshot> out) const;
+};
+
+/**
+ * @brief Replace snap by one determinization of observer's information set
+ * (shorthand for a Determinizer without HandKnowledge).
+ */
+void determinize(GameStateSnapshot &snap, uint8_t observer,
+                 tabletop_general::Rng &rng);
+
+} // namespace exploding_kittens
+
+#endif // EK_DETERMINIZATION_H
\ No newline at end of file
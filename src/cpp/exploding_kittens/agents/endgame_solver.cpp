@@ -0,0 +1,121 @@
+#include "endgame_solver.h"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+namespace exploding_kittens {
+
+EndgameSolver::EndgameSolver(EndgameConfig const &config)
+:
+    d_config(config),
+    d_memo(std::bit_floor(std::max<size_t>(
+        config.table_bytes / sizeof(MemoEntry), 1)))
+{}
+
+WinProbabilities EndgameSolver::solve(GameState const &g) {
+    load(g);
+    return value();
+}
+
+Action EndgameSolver::best_action(GameState const &g,
+                                  WinProbabilities *values) {
+    load(g);
+    ActionList legal;
+    Rules::append_legal_actions(d_game, legal);
+    if (legal.empty())
+        throw std::invalid_argument("No legal actions to choose from.");
+
+    uint8_t player = d_game.acting_player();
+    size_t best = 0;
+    WinProbabilities best_values{};
+    for (size_t idx = 0; idx != legal.size(); ++idx) {
+        WinProbabilities child = action_value(legal[idx]);
+        if (idx == 0 or child[player] > best_values[player]) {
+            best = idx;
+            best_values = child;
+        }
+    }
+    if (values != nullptr)
+        *values = best_values;
+    return legal[best];
+}
+
+void EndgameSolver::load(GameState const &g) {
+    if (g.cards.deck.size() > d_config.max_deck_size)
+        throw std::invalid_argument("Deck too large to solve.");
+
+    GameStateSnapshot snap;
+    g.save(snap);
+    d_game.restore(snap);
+    d_game.cards.deck.forget_unknown();
+    ++d_generation;
+}
+
+WinProbabilities EndgameSolver::value() {
+    WinProbabilities values{};
+    if (d_game.state == State::Game_Over) {
+        values[d_game.winner()] = 1.0;
+        return values;
+    }
+
+    uint64_t hash = d_game.hash();
+    if (probe(hash, values))
+        return values;
+    ++d_nodes;
+
+    ActionList legal;
+    Rules::append_legal_actions(d_game, legal);
+    if (legal.empty())
+        throw std::logic_error("Position without legal actions.");
+
+    // Max^n: the acting player picks what is best for itself.
+    uint8_t player = d_game.acting_player();
+    for (size_t idx = 0; idx != legal.size(); ++idx) {
+        WinProbabilities child = action_value(legal[idx]);
+        if (idx == 0 or child[player] > values[player])
+            values = child;
+    }
+    store(hash, values);
+    return values;
+}
+
+WinProbabilities EndgameSolver::action_value(Action const &a) {
+    ChanceEvent event;
+    Rules::chance_event(d_game, a, event);
+
+    WinProbabilities values{};
+    for (ChanceOutcome const &outcome : event) {
+        UndoRecord undo = Rules::make_action(d_game, a, outcome);
+        WinProbabilities child = value();
+        Rules::undo_action(d_game, undo);
+        for (size_t p = 0; p != MAX_PLAYERS; ++p)
+            values[p] += outcome.probability * child[p];
+    }
+    return values;
+}
+
+bool EndgameSolver::probe(uint64_t hash, WinProbabilities &out) const {
+    MemoEntry const &entry = d_memo[hash & (d_memo.size() - 1)];
+    if (not entry.used or entry.key != hash)
+        return false;
+    out = entry.values;
+    return true;
+}
+
+void EndgameSolver::store(uint64_t hash, WinProbabilities const &values) {
+    // Bigger decks mean bigger subtrees, which are worth keeping longer:
+    uint16_t depth = d_game.cards.deck.size();
+    MemoEntry &entry = d_memo[hash & (d_memo.size() - 1)];
+    if (entry.used and entry.key != hash and
+            entry.generation == d_generation and entry.depth > depth)
+        return;
+
+    entry.key = hash;
+    entry.used = true;
+    entry.generation = d_generation;
+    entry.depth = depth;
+    entry.values = values;
+}
+
+} // namespace exploding_kittens
\ No newline at end of file
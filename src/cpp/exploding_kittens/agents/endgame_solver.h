@@ -0,0 +1,125 @@
+#ifndef EK_ENDGAME_SOLVER_H
+#define EK_ENDGAME_SOLVER_H
+
+#include "../environment/game_state.h"
+#include "../environment/rules.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+
+namespace exploding_kittens {
+
+/**
+ * @brief Settings for the EndgameSolver.
+ */
+struct EndgameConfig {
+    size_t max_deck_size = 10;      // Larger decks are refused.
+    size_t table_bytes = 16 << 20;  // Memory budget of the memo table.
+};
+
+// Per player, the probability of winning the game.
+using WinProbabilities = std::array<double, MAX_PLAYERS>;
+
+/**
+ * @brief Solves small endgames exactly by expectimax. Decision nodes take the
+ * action that maximizes the win probability of the acting player (for more
+ * than two players: max^n), chance nodes average over every card the next
+ * draw can be, weighted by probability. Values get memoized on
+ * GameState::hash, so transpositions, such as drawing the same cards in
+ * another order, get solved once. The memo keeps them as doubles, so a
+ * memoized value is the same as a freshly computed one.
+ *
+ * The deck order is the only hidden information the solver models: a deck
+ * position that no player knows is a chance event, and positions that any
+ * player knows (kittens put back with a defuse) count as known by all (see
+ * CardStack::forget_unknown). The hands are taken as they are. The search
+ * steps through the outcomes of Rules::chance_event with make/undo on a
+ * single scratch game.
+ */
+class EndgameSolver {
+
+    // The win probabilities of a state. The memo is direct-mapped: an entry
+    // gets replaced by one of at least its depth (deck size), or by any from
+    // a later search.
+    struct MemoEntry {
+        uint64_t key = 0;
+        bool used = false;
+        uint8_t generation = 0;
+        uint16_t depth = 0;
+        WinProbabilities values{};
+    };
+
+    EndgameConfig d_config;
+    std::vector<MemoEntry> d_memo;  // Power of two size.
+    uint8_t d_generation = 0;       // Of the current search.
+    GameState d_game;       // Scratch game the search runs on.
+    size_t d_nodes = 0;     // Nodes expanded (not found in the table).
+
+    public:
+        EndgameSolver(EndgameConfig const &config = EndgameConfig{});
+
+        /**
+         * @brief Solve g: the win probabilities when every player plays
+         * optimally from here. g is not altered.
+         * @throws std::invalid_argument if the deck of g has more than
+         * config().max_deck_size cards.
+         */
+        WinProbabilities solve(GameState const &g);
+
+        /**
+         * @brief Solve g and return the best action for its acting player.
+         *
+         * @param g The state to solve. Is not altered.
+         * @param values If not null, set to the win probabilities after the
+         * best action.
+         * @throws std::invalid_argument if the deck is too large (see solve),
+         * or there are no legal actions in g.
+         */
+        Action best_action(GameState const &g,
+                           WinProbabilities *values = nullptr);
+
+        /**
+         * @return The number of positions expanded so far (table misses).
+         */
+        size_t nodes() const;
+
+        /**
+         * @brief Forget all memoized values.
+         */
+        void clear();
+
+        EndgameConfig const &config() const;
+
+    private:
+        // Copy g into d_game, turning unknown deck positions into chance.
+        void load(GameState const &g);
+
+        // The value of d_game, which is left as it was.
+        WinProbabilities value();
+
+        // The value of taking a in d_game, which is left as it was: the
+        // average over the outcomes of its chance event.
+        WinProbabilities action_value(Action const &a);
+
+        bool probe(uint64_t hash, WinProbabilities &out) const;
+        void store(uint64_t hash, WinProbabilities const &values);
+};
+
+inline size_t EndgameSolver::nodes() const {
+    return d_nodes;
+}
+
+inline void EndgameSolver::clear() {
+    std::fill(d_memo.begin(), d_memo.end(), MemoEntry{});
+}
+
+inline EndgameConfig const &EndgameSolver::config() const {
+    return d_config;
+}
+
+} // namespace exploding_kittens
+
+#endif // EK_ENDGAME_SOLVER_H
\ No newline at end of file
@@ -0,0 +1,143 @@
+#include "ismcts.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace exploding_kittens {
+
+Ismcts::Ismcts(IsmctsConfig const &config)
+:
+    d_config(config),
+    d_rng(config.seed)
+{
+    if (config.iterations == 0)
+        throw std::invalid_argument("Need at least one iteration.");
+    if (config.max_nodes < 2)
+        throw std::invalid_argument("Need room for the root and a child.");
+}
+
+Action Ismcts::search(GameState const &g) {
+    GameStateSnapshot root;
+    g.save(root);
+    d_game.restore(root);
+
+    d_legal.clear();
+    Rules::append_legal_actions(d_game, d_legal);
+    if (d_legal.empty())
+        throw std::invalid_argument("No legal actions to search over.");
+
+    d_nodes.clear();    // Keeps capacity: the arena gets reused.
+    d_nodes.push_back(Node{
+        Action{}, g.acting_player(), NO_NODE, NO_NODE, NO_NODE, 0, 0, 0.0});
+
+    d_root_children.clear();
+    if (d_legal.size() == 1) {  // Nothing to think about.
+        d_root_children.push_back(RootChild{d_legal[0], 0, 0.0});
+        return d_legal[0];
+    }
+
+    Determinizer infoset(root, g.acting_player());
+    for (size_t it = 0; it != d_config.iterations; ++it)
+        iterate(infoset);
+
+    for (uint32_t c = d_nodes[0].first_child; c != NO_NODE;
+         c = d_nodes[c].next_sibling)
+        d_root_children.push_back(
+            RootChild{d_nodes[c].action, d_nodes[c].visits, d_nodes[c].reward});
+
+    return std::max_element(d_root_children.begin(), d_root_children.end(),
+        [](RootChild const &a, RootChild const &b) {
+            return a.visits < b.visits;
+        })->action;
+}
+
+void Ismcts::iterate(Determinizer const &infoset) {
+    GameStateSnapshot snap;
+    infoset.sample(d_rng, snap);
+    snap.rng.seed(d_rng());     // Fresh randomness for future shuffles etc.
+    d_game.restore(snap);
+
+    d_path.clear();
+    d_path.push_back(0);
+    uint32_t node = 0;
+
+    // Selection and expansion:
+    while (d_game.state != State::Game_Over) {
+        d_legal.clear();
+        Rules::append_legal_actions(d_game, d_legal);
+        uint8_t player = d_game.acting_player();
+
+        // Match legal actions to children. Pick a random untried one, if any:
+        d_legal_children.clear();
+        size_t untried = 0;
+        Action expand_with{};
+        for (Action const &a : d_legal) {
+            uint32_t c = d_nodes[node].first_child;
+            while (c != NO_NODE and not (d_nodes[c].action == a and
+                                         d_nodes[c].player == player))
+                c = d_nodes[c].next_sibling;
+
+            if (c != NO_NODE) {
+                ++d_nodes[c].availability;
+                d_legal_children.push_back(c);
+            }
+            else if (d_rng.below(++untried) == 0)
+                expand_with = a;
+        }
+
+        if (untried != 0) {
+            uint32_t child = add_child(node, expand_with, player);
+            if (child != NO_NODE) {
+                ++d_nodes[child].availability;
+                d_path.push_back(child);
+                Rules::take_action(d_game, expand_with);
+            }
+            break;  // Only one expansion per iteration; now roll out.
+        }
+
+        // UCB over the children that are legal in this determinization:
+        uint32_t best = NO_NODE;
+        double best_score = -1.0;
+        for (uint32_t c : d_legal_children) {
+            Node const &n = d_nodes[c];
+            double score = n.reward / n.visits + d_config.exploration *
+                std::sqrt(std::log(static_cast<double>(n.availability)) /
+                          n.visits);
+            if (score > best_score) {
+                best_score = score;
+                best = c;
+            }
+        }
+        node = best;
+        d_path.push_back(node);
+        Rules::take_action(d_game, d_nodes[node].action);
+    }
+
+    // Random rollout:
+    while (d_game.state != State::Game_Over) {
+        d_legal.clear();
+        Rules::append_legal_actions(d_game, d_legal);
+        Rules::take_action(d_game, d_legal[d_rng.below(d_legal.size())]);
+    }
+
+    // Back up:
+    uint8_t winner = d_game.winner();
+    for (uint32_t n : d_path) {
+        ++d_nodes[n].visits;
+        if (d_nodes[n].player == winner)
+            d_nodes[n].reward += 1.0;
+    }
+}
+
+uint32_t Ismcts::add_child(uint32_t parent, Action const &a, uint8_t player) {
+    if (d_nodes.size() >= d_config.max_nodes)
+        return NO_NODE;
+    uint32_t idx = d_nodes.size();
+    d_nodes.push_back(Node{
+        a, player, parent, NO_NODE, d_nodes[parent].first_child, 0, 0, 0.0});
+    d_nodes[parent].first_child = idx;
+    return idx;
+}
+
+} // namespace exploding_kittens
\ No newline at end of file
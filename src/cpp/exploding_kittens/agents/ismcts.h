@@ -0,0 +1,126 @@
+#ifndef EK_ISMCTS_H
+#define EK_ISMCTS_H
+
+#include "../environment/game_state.h"
+#include "../environment/rules.h"
+#include "determinization.h"
+#include "../../utils.h"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+
+namespace exploding_kittens {
+
+/**
+ * @brief Settings for the Ismcts search engine.
+ */
+struct IsmctsConfig {
+    size_t iterations = 10000;      // Determinize-select-rollout cycles/search.
+    double exploration = 0.7;       // UCB exploration constant.
+    size_t max_nodes = 1 << 20;     // Node arena capacity. When it is full,
+                                    // the tree stops growing.
+    uint64_t seed = 0;              // Seed for the engine's own generator.
+};
+
+/**
+ * @brief Single-observer Information Set Monte Carlo Tree Search (Cowling et
+ * al. 2012). Every iteration samples a determinization: the cards the
+ * searching player can't see (the deck order and the hands of living
+ * opponents) are shuffled among each other. The single tree is then walked
+ * down for that determinization, using UCB with availability counts, one node
+ * is expanded, and the game is played out with random actions.
+ *
+ * Nodes are taken from an arena that is allocated once and reused by every
+ * search, so a search does no heap allocations once warmed up.
+ */
+class Ismcts {
+
+    public:
+        /**
+         * @brief Statistics of one child of the root, after a search.
+         */
+        struct RootChild {
+            Action action;
+            uint32_t visits;
+            double reward;  // Summed reward for the player at the root.
+        };
+
+        /**
+         * @throws std::invalid_argument if config has no iterations, or
+         * max_nodes is below 2 (room for the root and one child).
+         */
+        Ismcts(IsmctsConfig const &config = IsmctsConfig{});
+
+        /**
+         * @brief Search from the point of view of g.acting_player().
+         *
+         * @param g The state to search from. Is not altered.
+         * @return The most visited action at the root.
+         * @throws std::invalid_argument if there are no legal actions in g.
+         */
+        Action search(GameState const &g);
+
+        /**
+         * @return Statistics for all root children of the last search.
+         */
+        std::span<RootChild const> root_children() const;
+
+        /**
+         * @return The number of nodes in the tree of the last search.
+         */
+        size_t tree_size() const;
+
+        IsmctsConfig const &config() const;
+
+    private:
+        static constexpr uint32_t NO_NODE = UINT32_MAX;
+
+        struct Node {
+            Action action;          // Action that lead to this node.
+            uint8_t player;         // Player that chose said action.
+            uint32_t parent;
+            uint32_t first_child;
+            uint32_t next_sibling;
+            uint32_t visits;
+            uint32_t availability;  // Times it was legal when parent visited.
+            double reward;          // Summed reward for player.
+        };
+
+        IsmctsConfig d_config;
+        tabletop_general::Rng d_rng;
+
+        std::vector<Node> d_nodes;  // The arena. Node 0 is the root.
+        std::vector<RootChild> d_root_children;
+
+        // Scratch game that every iteration gets played out on:
+        GameState d_game;
+
+        // Reused buffers:
+        ActionList d_legal;
+        std::vector<uint32_t> d_path;
+        std::vector<uint32_t> d_legal_children;
+
+        // One iteration: descend, expand, roll out, back up.
+        void iterate(Determinizer const &infoset);
+
+        // Returns index of new node, or NO_NODE if the arena is full.
+        uint32_t add_child(uint32_t parent, Action const &a, uint8_t player);
+};
+
+inline std::span<Ismcts::RootChild const> Ismcts::root_children() const {
+    return d_root_children;
+}
+
+inline size_t Ismcts::tree_size() const {
+    return d_nodes.size();
+}
+
+inline IsmctsConfig const &Ismcts::config() const {
+    return d_config;
+}
+
+} // namespace exploding_kittens
+
+#endif // EK_ISMCTS_H
\ No newline at end of file
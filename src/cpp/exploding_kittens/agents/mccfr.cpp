@@ -0,0 +1,180 @@
+#include "mccfr.h"
+#include "../environment/observation.h"
+
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace exploding_kittens {
+
+uint64_t infoset_key(GameState const &g, uint8_t player) {
+    // Padded to whole words (with zeros):
+    std::array<uint8_t, (OBS_SIZE + 7) / 8 * 8> obs{};
+    encode_observation<uint8_t>(g, player,
+        std::span<uint8_t>(obs.data(), OBS_SIZE));
+
+    uint64_t hash = OBS_SIZE;
+    for (size_t idx = 0; idx != obs.size(); idx += 8) {
+        uint64_t word;
+        std::memcpy(&word, obs.data() + idx, sizeof(word));
+        hash = tabletop_general::mix64(hash ^ word);
+    }
+    return hash;
+}
+
+// Regret matching: probabilities proportional to the positive regrets, or
+// uniform if there are none (or the infoset is not stored).
+static void regret_matching(float const *block, size_t num_actions,
+                            std::span<double> out) {
+    double total = 0.0;
+    for (size_t a = 0; a != num_actions; ++a) {
+        out[a] = block == nullptr ? 0.0 :
+            std::max(0.0f, RegretTable::load(block + a));
+        total += out[a];
+    }
+    for (size_t a = 0; a != num_actions; ++a)
+        out[a] = total > 0.0 ? out[a] / total : 1.0 / num_actions;
+}
+
+Mccfr::Mccfr(MccfrConfig const &config)
+:
+    d_config(config),
+    d_table(config.table_bytes, config.avg_actions),
+    d_rng(config.seed)
+{
+    if (config.num_players < MIN_PLAYERS or config.num_players > MAX_PLAYERS)
+        throw std::invalid_argument("Invalid number of players.");
+    if (config.num_threads == 0)
+        throw std::invalid_argument("Need at least one thread.");
+}
+
+void Mccfr::run(size_t iterations) {
+    run_from(nullptr, iterations);
+}
+
+void Mccfr::run(GameState const &root, size_t iterations) {
+    GameStateSnapshot snap;
+    root.save(snap);
+    run_from(&snap, iterations);
+}
+
+void Mccfr::run_from(GameStateSnapshot const *root, size_t iterations) {
+    std::atomic<size_t> next = 0;
+    tabletop_general::Rng run_rng(d_rng());
+
+    // An exception can't leave a thread, so it is kept to rethrow after the
+    // join. The other threads then stop at their next iteration.
+    std::vector<std::exception_ptr> errors(d_config.num_threads);
+    size_t num_players = root ? root->num_players : d_config.num_players;
+    auto work = [&](size_t thread) {
+        try {
+            tabletop_general::Rng rng = run_rng.split(thread);
+            GameState g;
+            g.cards.deck.set_lazy(true);
+
+            while (next.fetch_add(1, std::memory_order_relaxed) < iterations) {
+                for (uint8_t traverser = 0; traverser != num_players;
+                     ++traverser) {
+                    if (root != nullptr) {
+                        g.restore(*root);
+                        g.cards.deck.forget_unknown();
+                        g.rng.seed(rng());
+                    } else {
+                        g.rng.seed(rng());
+                        g.reset(num_players);
+                    }
+                    traverse(g, traverser, rng);
+                }
+            }
+        } catch (...) {
+            errors[thread] = std::current_exception();
+            next.store(iterations, std::memory_order_relaxed);
+        }
+    };
+
+    {
+        std::vector<std::jthread> threads;
+        for (size_t t = 1; t < d_config.num_threads; ++t)
+            threads.emplace_back(work, t);
+        work(0);
+    }
+    for (std::exception_ptr const &error : errors)
+        if (error)
+            std::rethrow_exception(error);
+    d_iterations += iterations;
+}
+
+double Mccfr::traverse(GameState &g, uint8_t traverser,
+                       tabletop_general::Rng &rng) {
+    if (g.state == State::Game_Over)
+        return g.winner() == traverser ? 1.0 : -1.0;
+
+    ActionList legal;
+    Rules::append_legal_actions(g, legal);
+    if (legal.empty())
+        throw std::logic_error("Position without legal actions.");
+    if (legal.size() == 1) {    // No decision (but maybe chance, e.g. draws).
+        UndoRecord undo = Rules::make_action(g, legal[0]);
+        double value = traverse(g, traverser, rng);
+        Rules::undo_action(g, undo);
+        return value;
+    }
+
+    size_t num_actions = legal.size();
+    uint8_t player = g.acting_player();
+    float *block = d_table.find_or_insert(infoset_key(g, player), num_actions);
+    std::array<double, MAX_LEGAL_ACTIONS> strategy;
+    regret_matching(block, num_actions, strategy);
+
+    if (player == traverser) {  // Explore every action.
+        std::array<double, MAX_LEGAL_ACTIONS> values;
+        double node_value = 0.0;
+        for (size_t a = 0; a != num_actions; ++a) {
+            UndoRecord undo = Rules::make_action(g, legal[a]);
+            values[a] = traverse(g, traverser, rng);
+            Rules::undo_action(g, undo);
+            node_value += strategy[a] * values[a];
+        }
+        if (block != nullptr)
+            for (size_t a = 0; a != num_actions; ++a)
+                RegretTable::add(block + a, values[a] - node_value);
+        return node_value;
+    }
+
+    // Another player: sample one action, and add to its average strategy.
+    if (block != nullptr)
+        for (size_t a = 0; a != num_actions; ++a)
+            RegretTable::add(block + num_actions + a, strategy[a]);
+    double r = static_cast<double>(rng() >> 11) * 0x1.0p-53;
+    size_t pick = 0;
+    while (pick + 1 != num_actions and (r -= strategy[pick]) >= 0.0)
+        ++pick;
+
+    UndoRecord undo = Rules::make_action(g, legal[pick]);
+    double value = traverse(g, traverser, rng);
+    Rules::undo_action(g, undo);
+    return value;
+}
+
+bool Mccfr::average_strategy(GameState const &g, ActionList const &legal,
+                             std::span<double> out) const {
+    if (out.size() != legal.size())
+        throw std::invalid_argument("Need one output per legal action.");
+
+    float const *block = d_table.find(infoset_key(g, g.acting_player()));
+    double total = 0.0;
+    for (size_t a = 0; a != out.size(); ++a) {
+        out[a] = block == nullptr ? 0.0 :
+            RegretTable::load(block + out.size() + a);
+        total += out[a];
+    }
+    for (double &p : out)
+        p = total > 0.0 ? p / total : 1.0 / out.size();
+    return block != nullptr;
+}
+
+} // namespace exploding_kittens
\ No newline at end of file
@@ -0,0 +1,124 @@
+#ifndef EK_MCCFR_H
+#define EK_MCCFR_H
+
+#include "../environment/game_state.h"
+#include "../environment/rules.h"
+#include "regret_table.h"
+#include "../../utils.h"
+
+#include <cstdint>
+#include <span>
+
+
+namespace exploding_kittens {
+
+/**
+ * @brief Settings for Mccfr.
+ */
+struct MccfrConfig {
+    size_t num_players = 2;         // For games started by run(iterations).
+    size_t num_threads = 1;
+    size_t table_bytes = 1 << 30;   // Memory budget of the RegretTable.
+    size_t avg_actions = 4;         // See RegretTable.
+    uint64_t seed = 0;
+};
+
+/**
+ * @return The key of the information set of player in g: a hash of the
+ * observation of g by player (see encode_observation). States that look the
+ * same to player share a key, even if they were reached differently.
+ */
+uint64_t infoset_key(GameState const &g, uint8_t player);
+
+/**
+ * @brief External-sampling Monte Carlo CFR (Lanctot et al. 2009) over the
+ * Rules. An iteration walks the game tree once for every player (the
+ * traverser): at the traverser's decisions all actions get explored and
+ * their regrets updated, at the other players' decisions one action is
+ * sampled from the current strategy (regret matching), whose probabilities
+ * are added to the average strategy. Chance gets sampled: every iteration
+ * deals a new game with a lazy deck, so the deck order gets drawn while
+ * playing. Nodes with a single legal action are passed through without a
+ * table entry. Rewards are +1 for the winner, -1 for the others.
+ *
+ * Infosets are identified by infoset_key, and their regrets live in a
+ * RegretTable that all threads share. Walks run with make/undo on one game
+ * per thread.
+ */
+class Mccfr {
+
+    MccfrConfig d_config;
+    RegretTable d_table;
+    tabletop_general::Rng d_rng;    // Seeds the runs.
+    size_t d_iterations = 0;
+
+    public:
+        /**
+         * @throws std::invalid_argument if the number of players or threads
+         * is invalid.
+         */
+        Mccfr(MccfrConfig const &config = MccfrConfig{});
+
+        /**
+         * @brief Run iterations, each from a newly dealt game, divided over
+         * config().num_threads threads.
+         */
+        void run(size_t iterations);
+
+        /**
+         * @brief Run iterations from root instead. The deck positions no
+         * player knows get drawn anew every iteration (see
+         * CardStack::forget_unknown); the hands stay as they are in root.
+         * @throws std::logic_error if a position without legal actions is
+         * reached (e.g. in a State Rules does not implement). The
+         * iterations of an interrupted run do not count.
+         */
+        void run(GameState const &root, size_t iterations);
+
+        /**
+         * @brief The average strategy of g.acting_player() in g: the
+         * probability of each action in legal, which should be the legal
+         * actions of g (as given by Rules::append_legal_actions).
+         *
+         * @param out Output, with one probability per legal action. Uniform
+         * for infosets that were never visited.
+         * @return Whether the infoset was in the table.
+         * @throws std::invalid_argument if out and legal differ in length.
+         */
+        bool average_strategy(GameState const &g, ActionList const &legal,
+                              std::span<double> out) const;
+
+        /**
+         * @return The number of iterations run so far.
+         */
+        size_t iterations() const;
+
+        RegretTable const &table() const;
+
+        MccfrConfig const &config() const;
+
+    private:
+        // Runs iterations on the worker threads, from root (or new games if
+        // root is null).
+        void run_from(GameStateSnapshot const *root, size_t iterations);
+
+        // The expected reward of traverser in g, which is left as it was.
+        double traverse(GameState &g, uint8_t traverser,
+                        tabletop_general::Rng &rng);
+};
+
+inline size_t Mccfr::iterations() const {
+    return d_iterations;
+}
+
+inline RegretTable const &Mccfr::table() const {
+    return d_table;
+}
+
+inline MccfrConfig const &Mccfr::config() const {
+    return d_config;
+}
+
+} // namespace exploding_kittens
+
+#endif // EK_MCCFR_H
\ No newline at end of file
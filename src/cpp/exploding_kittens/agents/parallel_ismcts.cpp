@@ -0,0 +1,272 @@
+#include "parallel_ismcts.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+namespace exploding_kittens {
+
+struct ParallelIsmcts::TreeWorker {
+    GameState game;
+    tabletop_general::Rng rng;
+
+    ActionList legal;
+    std::vector<uint32_t> path;
+    std::vector<uint32_t> legal_children;
+
+    TreeWorker(tabletop_general::Rng rng)
+    :
+        rng(rng)
+    {}
+};
+
+ParallelIsmcts::ParallelIsmcts(ParallelIsmctsConfig const &config)
+:
+    d_config(config),
+    d_num_nodes(0),
+    d_iterations_started(0)
+{
+    if (config.num_threads == 0)
+        throw std::invalid_argument("Need at least one thread.");
+    if (config.search.iterations == 0)
+        throw std::invalid_argument("Need at least one iteration.");
+    if (config.search.max_nodes < 2)
+        throw std::invalid_argument("Need room for the root and a child.");
+    if (config.mode == Parallelism::Root and
+            config.search.iterations < config.num_threads)
+        throw std::invalid_argument("Root parallelism needs at least one "
+                                    "iteration per thread.");
+
+    tabletop_general::Rng base(config.search.seed);
+    for (size_t t = 0; t != config.num_threads; ++t) {
+        if (config.mode == Parallelism::Root) {
+            IsmctsConfig sub = config.search;
+            sub.iterations = config.search.iterations / config.num_threads +
+                (t < config.search.iterations % config.num_threads ? 1 : 0);
+            sub.seed = base.split(t)();
+            d_engines.push_back(std::make_unique<Ismcts>(sub));
+        }
+        else
+            d_workers.push_back(std::make_unique<TreeWorker>(base.split(t)));
+    }
+    if (config.mode == Parallelism::Tree)
+        d_nodes.reset(new SharedNode[config.search.max_nodes]);
+}
+
+ParallelIsmcts::~ParallelIsmcts() = default;
+
+Action ParallelIsmcts::search(GameState const &g) {
+    d_root_children.clear();
+    if (d_config.mode == Parallelism::Root)
+        search_root(g);
+    else
+        search_tree(g);
+
+    return std::max_element(d_root_children.begin(), d_root_children.end(),
+        [](RootChild const &a, RootChild const &b) {
+            return a.visits < b.visits;
+        })->action;
+}
+
+void ParallelIsmcts::search_root(GameState const &g) {
+    // Checked here, as an exception can't leave the threads below:
+    ActionList legal;
+    Rules::append_legal_actions(g, legal);
+    if (legal.empty())
+        throw std::invalid_argument("No legal actions to search over.");
+
+    {
+        std::vector<std::jthread> threads;
+        for (auto &engine : d_engines)  // Only reads g, so can be shared.
+            threads.emplace_back([&]() { engine->search(g); });
+    }
+
+    // Summing the statistics of identical root actions:
+    for (auto &engine : d_engines) {
+        for (RootChild const &child : engine->root_children()) {
+            auto it = std::find_if(d_root_children.begin(),
+                d_root_children.end(), [&](RootChild const &c) {
+                    return c.action == child.action;
+                });
+            if (it == d_root_children.end())
+                d_root_children.push_back(child);
+            else {
+                it->visits += child.visits;
+                it->reward += child.reward;
+            }
+        }
+    }
+}
+
+void ParallelIsmcts::search_tree(GameState const &g) {
+    GameStateSnapshot root;
+    g.save(root);
+    uint8_t observer = g.acting_player();
+
+    TreeWorker &first = *d_workers.front();
+    first.game.restore(root);
+    first.legal.clear();
+    Rules::append_legal_actions(first.game, first.legal);
+    if (first.legal.empty())
+        throw std::invalid_argument("No legal actions to search over.");
+    if (first.legal.size() == 1) {  // Nothing to think about.
+        d_root_children.push_back(RootChild{first.legal[0], 0, 0.0});
+        return;
+    }
+
+    // Fresh root:
+    SharedNode &r = d_nodes[0];
+    r.action = Action{};
+    r.player = observer;
+    r.first_child = NO_NODE;
+    r.next_sibling = NO_NODE;
+    r.visits = 0;
+    r.availability = 0;
+    r.in_flight = 0;
+    r.reward = 0.0;
+    d_num_nodes = 1;
+    d_iterations_started = 0;
+
+    Determinizer infoset(root, observer);
+    {
+        std::vector<std::jthread> threads;
+        for (auto &worker : d_workers)
+            threads.emplace_back([&]() {
+                while (d_iterations_started.fetch_add(1,
+                        std::memory_order_relaxed) < d_config.search.iterations)
+                    iterate_shared(*worker, infoset);
+            });
+    }
+
+    for (uint32_t c = d_nodes[0].first_child; c != NO_NODE;
+         c = d_nodes[c].next_sibling)
+        d_root_children.push_back(RootChild{
+            d_nodes[c].action, d_nodes[c].visits, d_nodes[c].reward});
+}
+
+void ParallelIsmcts::iterate_shared(TreeWorker &w,
+                                    Determinizer const &infoset) {
+    GameStateSnapshot snap;
+    infoset.sample(w.rng, snap);
+    snap.rng.seed(w.rng());
+    w.game.restore(snap);
+
+    constexpr auto relaxed = std::memory_order_relaxed;
+    constexpr auto acquire = std::memory_order_acquire;
+
+    w.path.clear();
+    w.path.push_back(0);
+    d_nodes[0].in_flight.fetch_add(1, relaxed);
+    uint32_t node = 0;
+
+    // Selection and expansion:
+    while (w.game.state != State::Game_Over) {
+        w.legal.clear();
+        Rules::append_legal_actions(w.game, w.legal);
+        uint8_t player = w.game.acting_player();
+
+        w.legal_children.clear();
+        size_t untried = 0;
+        Action expand_with{};
+        for (Action const &a : w.legal) {
+            uint32_t c = d_nodes[node].first_child.load(acquire);
+            while (c != NO_NODE and not (d_nodes[c].action == a and
+                                         d_nodes[c].player == player))
+                c = d_nodes[c].next_sibling;
+
+            if (c != NO_NODE) {
+                d_nodes[c].availability.fetch_add(1, relaxed);
+                w.legal_children.push_back(c);
+            }
+            else if (w.rng.below(++untried) == 0)
+                expand_with = a;
+        }
+
+        if (untried != 0) {
+            uint32_t child = shared_child(node, expand_with, player);
+            if (child != NO_NODE) {
+                d_nodes[child].availability.fetch_add(1, relaxed);
+                d_nodes[child].in_flight.fetch_add(1, relaxed);
+                w.path.push_back(child);
+                Rules::take_action(w.game, expand_with);
+            }
+            break;
+        }
+
+        // UCB with virtual loss: in-flight visits count, but without reward.
+        uint32_t best = NO_NODE;
+        double best_score = -1.0;
+        for (uint32_t c : w.legal_children) {
+            SharedNode const &n = d_nodes[c];
+            double visits = n.visits.load(relaxed) +
+                d_config.virtual_loss * n.in_flight.load(relaxed);
+            double score = visits == 0.0 ?
+                std::numeric_limits<double>::infinity() :
+                n.reward.load(relaxed) / visits + d_config.search.exploration *
+                    std::sqrt(std::log(static_cast<double>(
+                        n.availability.load(relaxed))) / visits);
+            if (score > best_score) {
+                best_score = score;
+                best = c;
+            }
+        }
+        node = best;
+        d_nodes[node].in_flight.fetch_add(1, relaxed);
+        w.path.push_back(node);
+        Rules::take_action(w.game, d_nodes[node].action);
+    }
+
+    // Random rollout:
+    while (w.game.state != State::Game_Over) {
+        w.legal.clear();
+        Rules::append_legal_actions(w.game, w.legal);
+        Rules::take_action(w.game, w.legal[w.rng.below(w.legal.size())]);
+    }
+
+    // Back up, removing the virtual loss again:
+    uint8_t winner = w.game.winner();
+    for (uint32_t n : w.path) {
+        d_nodes[n].visits.fetch_add(1, relaxed);
+        if (d_nodes[n].player == winner)
+            d_nodes[n].reward.fetch_add(1.0, relaxed);
+        d_nodes[n].in_flight.fetch_sub(1, relaxed);
+    }
+}
+
+uint32_t ParallelIsmcts::shared_child(uint32_t parent, Action const &a,
+                                      uint8_t player) {
+    std::atomic<uint32_t> &head_ref = d_nodes[parent].first_child;
+    uint32_t head = head_ref.load(std::memory_order_acquire);
+    uint32_t fresh = NO_NODE;
+
+    while (true) {
+        // Another thread might have added it in the meantime:
+        for (uint32_t c = head; c != NO_NODE; c = d_nodes[c].next_sibling)
+            if (d_nodes[c].action == a and d_nodes[c].player == player)
+                return c;   // (A fresh node, if any, stays unused.)
+
+        if (fresh == NO_NODE) {
+            fresh = d_num_nodes.fetch_add(1, std::memory_order_relaxed);
+            if (fresh >= d_config.search.max_nodes)
+                return NO_NODE;
+            SharedNode &n = d_nodes[fresh];
+            n.action = a;
+            n.player = player;
+            n.first_child.store(NO_NODE, std::memory_order_relaxed);
+            n.visits.store(0, std::memory_order_relaxed);
+            n.availability.store(0, std::memory_order_relaxed);
+            n.in_flight.store(0, std::memory_order_relaxed);
+            n.reward.store(0.0, std::memory_order_relaxed);
+        }
+
+        // Publish: the release makes the fields above visible to readers.
+        d_nodes[fresh].next_sibling = head;
+        if (head_ref.compare_exchange_weak(head, fresh,
+                std::memory_order_release, std::memory_order_acquire))
+            return fresh;
+    }
+}
+
+} // namespace exploding_kittens
\ No newline at end of file
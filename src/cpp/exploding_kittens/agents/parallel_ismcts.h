@@ -0,0 +1,132 @@
+#ifndef EK_PARALLEL_ISMCTS_H
+#define EK_PARALLEL_ISMCTS_H
+
+#include "ismcts.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+
+namespace exploding_kittens {
+
+/**
+ * @brief How ParallelIsmcts divides a search over its threads.
+ */
+enum class Parallelism : uint8_t {
+    Root,   // Every thread grows its own tree; root statistics get summed.
+    Tree    // All threads grow one shared tree, using virtual loss.
+};
+
+/**
+ * @brief Settings for ParallelIsmcts.
+ */
+struct ParallelIsmctsConfig {
+    IsmctsConfig search;        // search.iterations is the total over threads.
+    size_t num_threads = 1;
+    Parallelism mode = Parallelism::Root;
+    double virtual_loss = 1.0;  // Tree mode: visits a thread in flight counts
+                                // as (without reward) for the other threads.
+};
+
+/**
+ * @brief Runs ISMCTS on multiple threads for one decision. The parallelization
+ * scheme can be chosen at runtime:
+ * - Root: one independent Ismcts engine per thread, each seeded with its own
+ *   stream and doing its share of the iterations. The statistics of equal
+ *   root actions are summed afterwards.
+ * - Tree: a single tree with atomic node statistics. Nodes are allocated from
+ *   a fixed arena with an atomic counter, and children are pushed onto their
+ *   parent's list with a compare-and-swap, so no locks are needed. A thread
+ *   that walks through a node adds virtual loss to it until it backs up, which
+ *   steers the other threads towards different parts of the tree.
+ */
+class ParallelIsmcts {
+
+    public:
+        using RootChild = Ismcts::RootChild;
+
+        /**
+         * @throws std::invalid_argument if config has no threads, no
+         * iterations, a max_nodes below 2, or (Root mode) fewer iterations
+         * than threads.
+         */
+        ParallelIsmcts(ParallelIsmctsConfig const &config);
+        ~ParallelIsmcts();
+
+        // Disable copy and move semantics (workers refer to their games).
+        ParallelIsmcts(const ParallelIsmcts &) = delete;
+        ParallelIsmcts &operator=(const ParallelIsmcts &) = delete;
+        ParallelIsmcts(ParallelIsmcts &&) = delete;
+        ParallelIsmcts &operator=(ParallelIsmcts &&) = delete;
+
+        /**
+         * @brief Search from the point of view of g.acting_player().
+         *
+         * @param g The state to search from. Is not altered.
+         * @return The most visited action at the root.
+         * @throws std::invalid_argument if there are no legal actions in g.
+         */
+        Action search(GameState const &g);
+
+        /**
+         * @return (Merged) statistics for all root children of the last search.
+         */
+        std::span<RootChild const> root_children() const;
+
+        ParallelIsmctsConfig const &config() const;
+
+    private:
+        static constexpr uint32_t NO_NODE = UINT32_MAX;
+
+        // Tree mode node: the statistics get updated by all threads.
+        struct SharedNode {
+            Action action;
+            uint8_t player;
+            std::atomic<uint32_t> first_child;
+            uint32_t next_sibling;  // Written before the node is published.
+            std::atomic<uint32_t> visits;
+            std::atomic<uint32_t> availability;
+            std::atomic<uint32_t> in_flight;    // Threads below this node.
+            std::atomic<double> reward;
+        };
+
+        struct TreeWorker;  // Per-thread scratch state for Tree mode.
+
+        ParallelIsmctsConfig d_config;
+        std::vector<RootChild> d_root_children;
+
+        // Root mode:
+        std::vector<std::unique_ptr<Ismcts>> d_engines;
+
+        // Tree mode:
+        std::unique_ptr<SharedNode[]> d_nodes;
+        std::atomic<uint32_t> d_num_nodes;
+        std::atomic<size_t> d_iterations_started;
+        std::vector<std::unique_ptr<TreeWorker>> d_workers;
+
+        void search_root(GameState const &g);
+        void search_tree(GameState const &g);
+
+        // One Tree mode iteration, run by worker w.
+        void iterate_shared(TreeWorker &w, Determinizer const &infoset);
+
+        // Finds or (lock-free) creates the child of parent for action a.
+        // Returns NO_NODE if the arena is full.
+        uint32_t shared_child(uint32_t parent, Action const &a, uint8_t player);
+};
+
+inline std::span<ParallelIsmcts::RootChild const>
+ParallelIsmcts::root_children() const {
+    return d_root_children;
+}
+
+inline ParallelIsmctsConfig const &ParallelIsmcts::config() const {
+    return d_config;
+}
+
+} // namespace exploding_kittens
+
+#endif // EK_PARALLEL_ISMCTS_H
\ No newline at end of file
@@ -0,0 +1,66 @@
+#include "regret_table.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace exploding_kittens {
+
+RegretTable::RegretTable(size_t max_bytes, size_t avg_actions)
+:
+    d_num_slots(std::bit_floor(std::max<size_t>(
+        max_bytes / (sizeof(uint64_t) + sizeof(uint32_t) +
+                     2 * sizeof(float) * std::max<size_t>(avg_actions, 1)),
+        1))),
+    d_num_pairs(std::min<size_t>(
+        (max_bytes - std::min(max_bytes, d_num_slots * (sizeof(uint64_t) +
+                                                        sizeof(uint32_t)))) /
+            (2 * sizeof(float)),
+        NO_BLOCK - 1)),
+    d_keys(new std::atomic<uint64_t>[d_num_slots]()),
+    d_blocks(new std::atomic<uint32_t>[d_num_slots]()),
+    d_values(new float[2 * d_num_pairs]())
+{}
+
+float const *RegretTable::find(uint64_t key) const {
+    key = nonzero(key);
+    for (size_t probe = 0; probe != MAX_PROBES; ++probe) {
+        size_t idx = (key + probe) & (d_num_slots - 1);
+        uint64_t stored = d_keys[idx].load(std::memory_order_acquire);
+        if (stored == key)
+            return block(d_blocks[idx].load(std::memory_order_acquire));
+        if (stored == 0)
+            return nullptr;
+    }
+    return nullptr;
+}
+
+float *RegretTable::find_or_insert(uint64_t key, size_t num_actions) {
+    key = nonzero(key);
+    for (size_t probe = 0; probe != MAX_PROBES; ++probe) {
+        size_t idx = (key + probe) & (d_num_slots - 1);
+        uint64_t stored = d_keys[idx].load(std::memory_order_acquire);
+        if (stored == 0 and d_keys[idx].compare_exchange_strong(stored, key,
+                std::memory_order_acq_rel)) {
+            // Claimed the slot: get a block from the arena, and publish it.
+            size_t offset = d_pairs_used.fetch_add(num_actions,
+                std::memory_order_relaxed);
+            uint32_t published = offset + num_actions <= d_num_pairs ?
+                static_cast<uint32_t>(offset + 1) : NO_BLOCK;
+            d_blocks[idx].store(published, std::memory_order_release);
+            if (published != NO_BLOCK)
+                d_size.fetch_add(1, std::memory_order_relaxed);
+            return block(published);
+        }
+        // Either it was occupied, or another thread just claimed it:
+        if (stored == key)
+            return block(d_blocks[idx].load(std::memory_order_acquire));
+    }
+    return nullptr;
+}
+
+size_t RegretTable::bytes() const {
+    return d_num_slots * (sizeof(uint64_t) + sizeof(uint32_t)) +
+           d_num_pairs * 2 * sizeof(float);
+}
+
+} // namespace exploding_kittens
\ No newline at end of file
@@ -0,0 +1,144 @@
+#ifndef EK_REGRET_TABLE_H
+#define EK_REGRET_TABLE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+
+namespace exploding_kittens {
+
+/**
+ * @brief Per information set the cumulative regrets and strategy sums of
+ * Mccfr, in a fixed memory budget.
+ *
+ * An open-addressing hash table (linear probing) maps 64-bit infoset keys to
+ * a block of 2 * num_actions floats in one big arena: first the regrets, then
+ * the strategy sums. A slot is 12 bytes (key and block offset), a block 8
+ * bytes per action. Both arrays are allocated once. When either is full, new
+ * infosets are simply not stored (find_or_insert returns nullptr), so the
+ * memory stays bounded however many infosets the game has.
+ *
+ * All threads can use the table at once without locks. A slot gets claimed
+ * with a compare-and-swap on its key, and its block published after that with
+ * a release store. Until then, the infoset counts as not stored. The floats
+ * are accessed with relaxed atomic loads and stores (see load and add), so
+ * concurrent updates of one infoset can lose an update, which MCCFR
+ * tolerates.
+ */
+class RegretTable {
+
+    public:
+        /**
+         * @brief Allocates (and zeroes) the table.
+         *
+         * @param max_bytes The memory budget.
+         * @param avg_actions The expected number of actions per stored
+         * infoset, which decides how the budget gets divided over slots (a
+         * power of two, at least one) and the arena.
+         */
+        RegretTable(size_t max_bytes, size_t avg_actions = 4);
+
+        // Disable copy and move semantics (other threads may hold pointers):
+        RegretTable(const RegretTable &) = delete;
+        RegretTable &operator=(const RegretTable &) = delete;
+        RegretTable(RegretTable &&) = delete;
+        RegretTable &operator=(RegretTable &&) = delete;
+
+        /**
+         * @brief Look up an infoset.
+         *
+         * @return Its block, or nullptr if it is not stored.
+         */
+        float const *find(uint64_t key) const;
+
+        /**
+         * @brief Look up an infoset, and add it (with a zeroed block) if it
+         * is not there yet. A key should always come with the same number of
+         * actions.
+         *
+         * @return Its block, or nullptr if there was no room for it.
+         */
+        float *find_or_insert(uint64_t key, size_t num_actions);
+
+        /**
+         * @return The number of stored infosets.
+         */
+        size_t size() const;
+
+        /**
+         * @return The number of slots (an upper bound to size()).
+         */
+        size_t capacity() const;
+
+        /**
+         * @return The memory used by the table, in bytes.
+         */
+        size_t bytes() const;
+
+        /**
+         * @return A value in a block, read atomically (relaxed).
+         */
+        static float load(float const *value);
+
+        /**
+         * @brief Add delta to a value in a block, as an atomic (relaxed)
+         * load and store. A concurrent update of the same value can get lost.
+         */
+        static void add(float *value, float delta);
+
+    private:
+        static constexpr size_t MAX_PROBES = 64;    // Then it counts as full.
+
+        // Stored in d_blocks: block offset in pairs of floats, plus one.
+        static constexpr uint32_t UNPUBLISHED = 0;
+        static constexpr uint32_t NO_BLOCK = UINT32_MAX;    // Arena was full.
+
+        size_t d_num_slots;     // A power of two.
+        size_t d_num_pairs;     // Arena size, in pairs of floats.
+        std::unique_ptr<std::atomic<uint64_t>[]> d_keys;    // 0 is empty.
+        std::unique_ptr<std::atomic<uint32_t>[]> d_blocks;
+        std::unique_ptr<float[]> d_values;
+        std::atomic<size_t> d_pairs_used = 0;
+        std::atomic<size_t> d_size = 0;
+
+        // Keys are never 0 (that marks an empty slot):
+        static uint64_t nonzero(uint64_t key);
+
+        // The block of a published slot, or nullptr.
+        float *block(uint32_t stored) const;
+};
+
+inline size_t RegretTable::size() const {
+    return d_size.load(std::memory_order_relaxed);
+}
+
+inline size_t RegretTable::capacity() const {
+    return d_num_slots;
+}
+
+inline float RegretTable::load(float const *value) {
+    return std::atomic_ref<float>(*const_cast<float *>(value)).load(
+        std::memory_order_relaxed);
+}
+
+inline void RegretTable::add(float *value, float delta) {
+    std::atomic_ref<float> ref(*value);
+    ref.store(ref.load(std::memory_order_relaxed) + delta,
+              std::memory_order_relaxed);
+}
+
+inline uint64_t RegretTable::nonzero(uint64_t key) {
+    return key == 0 ? 1 : key;
+}
+
+inline float *RegretTable::block(uint32_t stored) const {
+    if (stored == UNPUBLISHED or stored == NO_BLOCK)
+        return nullptr;
+    return d_values.get() + 2 * static_cast<size_t>(stored - 1);
+}
+
+} // namespace exploding_kittens
+
+#endif // EK_REGRET_TABLE_H
\ No newline at end of file
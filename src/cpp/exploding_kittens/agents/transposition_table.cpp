@@ -0,0 +1,85 @@
+#include "transposition_table.h"
+
+#include <algorithm>
+
+namespace exploding_kittens {
+
+TranspositionTable::TranspositionTable(size_t max_bytes, Replacement policy)
+:
+    d_policy(policy),
+    d_generation(0),
+    d_num_buckets(std::bit_floor(
+        std::max<size_t>(max_bytes / sizeof(Bucket), 1))),
+    d_buckets(new Bucket[d_num_buckets])
+{
+    clear();
+}
+
+void TranspositionTable::store(uint64_t key, TTValue value) {
+    value.generation = d_generation;
+    uint64_t data = std::bit_cast<uint64_t>(value);
+    constexpr auto relaxed = std::memory_order_relaxed;
+
+    Bucket &b = bucket(key);
+    Slot *target = nullptr;
+    int target_score = INT32_MAX;
+    for (Slot &slot : b.slots) {
+        uint64_t old_data = slot.data.load(relaxed);
+        uint64_t old_check = slot.check.load(relaxed);
+
+        if ((old_check | old_data) == 0) {         // Empty.
+            if (target_score > INT32_MIN) {
+                target = &slot;
+                target_score = INT32_MIN;
+            }
+            continue;
+        }
+
+        TTValue old = std::bit_cast<TTValue>(old_data);
+        if ((old_check ^ old_data) == key) {        // Same state.
+            if (d_policy == Replacement::Depth and old.depth > value.depth and
+                    old.generation == d_generation)
+                return;
+            target = &slot;
+            break;
+        }
+
+        if (d_policy == Replacement::Depth) {
+            // Every generation of age costs as much as 8 plies of depth:
+            uint8_t age = d_generation - old.generation;
+            int score = static_cast<int>(old.depth) - 8 * age;
+            if (score < target_score) {
+                target = &slot;
+                target_score = score;
+            }
+        }
+    }
+
+    if (target == nullptr)  // Always policy, full bucket, no match.
+        target = &b.slots[(key >> 32) % SLOTS];
+
+    target->data.store(data, relaxed);
+    target->check.store(key ^ data, relaxed);
+}
+
+void TranspositionTable::clear() {
+    for (size_t idx = 0; idx != d_num_buckets; ++idx) {
+        for (Slot &slot : d_buckets[idx].slots) {
+            slot.data.store(0, std::memory_order_relaxed);
+            slot.check.store(0, std::memory_order_relaxed);
+        }
+    }
+    d_generation = 0;
+}
+
+double TranspositionTable::fill_rate(size_t sample_buckets) const {
+    size_t num = std::min(sample_buckets, d_num_buckets);
+    size_t used = 0;
+    for (size_t idx = 0; idx != num; ++idx)
+        for (Slot const &slot : d_buckets[idx].slots)
+            used += (slot.data.load(std::memory_order_relaxed) |
+                     slot.check.load(std::memory_order_relaxed)) != 0;
+    return static_cast<double>(used) / (num * SLOTS);
+}
+
+} // namespace exploding_kittens
\ No newline at end of file
@@ -0,0 +1,168 @@
+#ifndef EK_TRANSPOSITION_TABLE_H
+#define EK_TRANSPOSITION_TABLE_H
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+
+namespace exploding_kittens {
+
+/**
+ * @brief What gets stored per state in a TranspositionTable. Exactly 8 bytes,
+ * so an entry can be written with one atomic store.
+ */
+struct TTValue {
+    float value;        // E.g. the expected reward, or a cached estimate.
+    uint16_t depth;     // Quality of value (search depth, visits, ...). Used
+                        // by the Depth replacement policy.
+    uint8_t flags;      // Free for the user (e.g. exact/lower/upper bound).
+    uint8_t generation; // Set by the table on store. Used to age entries.
+};
+
+static_assert(sizeof(TTValue) == sizeof(uint64_t), "TTValue must be 8 bytes.");
+
+/**
+ * @brief How a TranspositionTable picks an entry to overwrite when the bucket
+ * of a new key is full.
+ */
+enum class Replacement : uint8_t {
+    Always, // Overwrite one of the slots, chosen by the key's bits.
+    Depth   // Overwrite the slot with the least depth, where entries from
+            // older generations count as shallower. An entry for the same key
+            // only gets replaced by one with at least its depth.
+};
+
+/**
+ * @brief A fixed-size hash table from (GameState) hashes to TTValues that all
+ * threads can use concurrently without locks.
+ *
+ * The table is an array of cache-line sized buckets of 4 slots. A slot holds
+ * two atomic words: the data and the key xor-ed with the data. Reads and
+ * writes of the words can interleave between threads, but a torn entry fails
+ * the key check on probing and simply counts as a miss. Like any table
+ * without locks, a lost update (two threads storing at once) is possible.
+ */
+class TranspositionTable {
+
+    public:
+        /**
+         * @brief Allocates (and zeroes) the table.
+         *
+         * @param max_bytes The memory budget. The table gets the largest
+         * power of two number of buckets that fits, and at least one.
+         * @param policy The replacement policy used by store.
+         */
+        TranspositionTable(size_t max_bytes, Replacement policy =
+                           Replacement::Depth);
+
+        // Disable copy and move semantics (other threads may hold references):
+        TranspositionTable(const TranspositionTable &) = delete;
+        TranspositionTable &operator=(const TranspositionTable &) = delete;
+        TranspositionTable(TranspositionTable &&) = delete;
+        TranspositionTable &operator=(TranspositionTable &&) = delete;
+
+        /**
+         * @brief Look up key.
+         *
+         * @param key A GameState::hash().
+         * @param out Set to the stored value if found.
+         * @return true if key was found.
+         */
+        bool probe(uint64_t key, TTValue &out) const;
+
+        /**
+         * @brief Store (or update) the value for key, overwriting another
+         * entry if needed according to the replacement policy.
+         */
+        void store(uint64_t key, TTValue value);
+
+        /**
+         * @brief Start a new generation (e.g. a new search): entries from
+         * earlier generations get replaced first under the Depth policy.
+         */
+        void new_generation();
+
+        /**
+         * @brief Remove all entries.
+         */
+        void clear();
+
+        /**
+         * @return The number of entries that fit in the table.
+         */
+        size_t capacity() const;
+
+        /**
+         * @return The memory used by the table, in bytes.
+         */
+        size_t bytes() const;
+
+        /**
+         * @return The fraction of slots in use, estimated from (at most)
+         * sample_buckets buckets.
+         */
+        double fill_rate(size_t sample_buckets = 1024) const;
+
+        Replacement policy() const;
+
+    private:
+        static constexpr size_t SLOTS = 4;
+
+        struct Slot {
+            std::atomic<uint64_t> check;    // key ^ data
+            std::atomic<uint64_t> data;     // A TTValue
+        };
+
+        struct alignas(64) Bucket {
+            Slot slots[SLOTS];
+        };
+
+        static_assert(sizeof(Bucket) == 64, "Buckets should be a cache line.");
+
+        Replacement d_policy;
+        uint8_t d_generation;
+        size_t d_num_buckets;   // A power of two.
+        std::unique_ptr<Bucket[]> d_buckets;
+
+        Bucket &bucket(uint64_t key) const;
+};
+
+inline TranspositionTable::Bucket &
+TranspositionTable::bucket(uint64_t key) const {
+    return d_buckets[key & (d_num_buckets - 1)];
+}
+
+inline bool TranspositionTable::probe(uint64_t key, TTValue &out) const {
+    for (Slot const &slot : bucket(key).slots) {
+        uint64_t data = slot.data.load(std::memory_order_relaxed);
+        uint64_t check = slot.check.load(std::memory_order_relaxed);
+        if ((check ^ data) == key and (check | data) != 0) {
+            out = std::bit_cast<TTValue>(data);
+            return true;
+        }
+    }
+    return false;
+}
+
+inline void TranspositionTable::new_generation() {
+    ++d_generation;
+}
+
+inline size_t TranspositionTable::capacity() const {
+    return d_num_buckets * SLOTS;
+}
+
+inline size_t TranspositionTable::bytes() const {
+    return d_num_buckets * sizeof(Bucket);
+}
+
+inline Replacement TranspositionTable::policy() const {
+    return d_policy;
+}
+
+} // namespace exploding_kittens
+
+#endif // EK_TRANSPOSITION_TABLE_H
\ No newline at end of file
@@ -0,0 +1,135 @@
+#include "action_codec.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace exploding_kittens {
+
+namespace {
+
+using CardArray = std::array<uint8_t, UNIQUE_CARDS>;
+
+// Index of the card that is played num times in a combo, or UNIQUE_CARDS if
+// there is no such (single) card.
+size_t combo_card(CardArray const &cards, uint8_t num) {
+    size_t card = UNIQUE_CARDS;
+    for (size_t idx = 0; idx != UNIQUE_CARDS; ++idx) {
+        if (cards[idx] == 0)
+            continue;
+        if (cards[idx] != num or card != UNIQUE_CARDS)
+            return UNIQUE_CARDS;
+        card = idx;
+    }
+    return card;
+}
+
+// The action for each code, in code order.
+std::array<Action, NUM_ACTION_CODES> make_decode_table() {
+    std::array<Action, NUM_ACTION_CODES> table{};
+    size_t code = 0;
+    auto add = [&](ActionEnum type, CardArray const &cards, uint8_t arg1,
+                   uint8_t arg2) {
+        table[code++] = Action{type, cards, arg1, arg2};
+    };
+    auto single = [](CardIdx c) {
+        CardArray cards{};
+        cards[to_uint(c)] = 1U;
+        return cards;
+    };
+
+    add(ActionEnum::Draw, CardArray{}, 0U, 0U);
+
+    CardArray defuse{};
+    defuse[to_uint(CardIdx::Exploding_Kitten)] = 1U;
+    defuse[to_uint(CardIdx::Defuse)] = 1U;
+    for (size_t depth = 0; depth != MAX_CARDS + 1; ++depth)
+        add(ActionEnum::Play_Defuse, defuse, depth, 0U);
+
+    add(ActionEnum::Play_Nope, single(CardIdx::Nope), 0U, 0U);
+    add(ActionEnum::Skip_Nope, CardArray{}, 0U, 0U);
+    add(ActionEnum::Play_Skip, single(CardIdx::Skip), 0U, 0U);
+    add(ActionEnum::Play_Attack, single(CardIdx::Attack), 0U, 0U);
+    add(ActionEnum::Play_Shuffle, single(CardIdx::Shuffle), 0U, 0U);
+    add(ActionEnum::Play_See_Future, single(CardIdx::See_Future), 0U, 0U);
+
+    for (size_t player = 0; player != MAX_PLAYERS; ++player)
+        add(ActionEnum::Play_Favor, single(CardIdx::Favor), player, 0U);
+
+    for (size_t card = 0; card != UNIQUE_CARDS; ++card)
+        add(ActionEnum::Give_Favor, CardArray{}, card, 0U);
+
+    for (size_t card = 0; card != UNIQUE_CARDS; ++card) {
+        CardArray cards{};
+        cards[card] = 2U;
+        for (size_t player = 0; player != MAX_PLAYERS; ++player)
+            add(ActionEnum::Play_Two_Card_Combo, cards, player, 0U);
+    }
+
+    for (size_t card = 0; card != UNIQUE_CARDS; ++card) {
+        CardArray cards{};
+        cards[card] = 3U;
+        for (size_t player = 0; player != MAX_PLAYERS; ++player)
+            for (size_t target = 0; target != UNIQUE_CARDS; ++target)
+                add(ActionEnum::Play_Three_Card_Combo, cards, player, target);
+    }
+
+    return table;
+}
+
+} // namespace
+
+ActionCode encode_action(Action const &a) {
+    size_t idx = 0;
+    size_t card;
+    switch (a.type) {
+        case ActionEnum::Draw:
+        case ActionEnum::Play_Nope:
+        case ActionEnum::Skip_Nope:
+        case ActionEnum::Play_Skip:
+        case ActionEnum::Play_Attack:
+        case ActionEnum::Play_Shuffle:
+        case ActionEnum::Play_See_Future:
+            break;
+        case ActionEnum::Play_Defuse:
+        case ActionEnum::Play_Favor:
+        case ActionEnum::Give_Favor:
+            idx = a.arg1;
+            break;
+        case ActionEnum::Play_Two_Card_Combo:
+            card = combo_card(a.cards, 2U);
+            if (card == UNIQUE_CARDS or a.arg1 >= MAX_PLAYERS)
+                throw std::invalid_argument("Invalid two card combo.");
+            idx = card * MAX_PLAYERS + a.arg1;
+            break;
+        case ActionEnum::Play_Three_Card_Combo:
+            card = combo_card(a.cards, 3U);
+            if (card == UNIQUE_CARDS or a.arg1 >= MAX_PLAYERS or
+                    a.arg2 >= UNIQUE_CARDS)
+                throw std::invalid_argument("Invalid three card combo.");
+            idx = (card * MAX_PLAYERS + a.arg1) * UNIQUE_CARDS + a.arg2;
+            break;
+        default:
+            throw std::invalid_argument("Action type has no codes.");
+    }
+
+    size_t type = static_cast<size_t>(a.type);
+    if (idx >= ACTION_CODES_PER_TYPE[type])
+        throw std::invalid_argument("Action argument out of range.");
+    return ACTION_CODE_OFFSETS[type] + idx;
+}
+
+Action const &decode_action(ActionCode code) {
+    static std::array<Action, NUM_ACTION_CODES> const table =
+        make_decode_table();
+    return table.at(code);
+}
+
+void legal_action_mask(ActionList const &legal, std::span<uint8_t> mask) {
+    if (mask.size() != NUM_ACTION_CODES)
+        throw std::invalid_argument("Mask must have NUM_ACTION_CODES entries.");
+    std::fill(mask.begin(), mask.end(), 0U);
+    for (Action const &a : legal)
+        mask[encode_action(a)] = 1U;
+}
+
+} // namespace exploding_kittens
\ No newline at end of file
@@ -0,0 +1,86 @@
+#ifndef EK_ACTION_CODEC_H
+#define EK_ACTION_CODEC_H
+
+#include "action_defs.h"
+#include "action_list.h"
+#include "game_defs.h"
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+
+namespace exploding_kittens {
+
+/**
+ * @brief An action as a single integer in the flat discrete action space:
+ * every (type, arg1, arg2) combination gets its own code. The cards that get
+ * played follow from the rest, so they don't need to be stored. Codes for a
+ * type are contiguous, in ActionEnum order:
+ *
+ * | Type                  | Codes                          | Args              |
+ * |-----------------------|--------------------------------|-------------------|
+ * | Draw                  | 1                              |                   |
+ * | Play_Defuse           | MAX_CARDS + 1                  | depth             |
+ * | Play_Nope ... See_Fut | 1 each                         |                   |
+ * | Play_Favor            | MAX_PLAYERS                    | player            |
+ * | Give_Favor            | UNIQUE_CARDS                   | card to give      |
+ * | Play_Two_Card_Combo   | UNIQUE_CARDS * MAX_PLAYERS     | card, player      |
+ * | Play_Three_Card_Combo | UNIQUE_CARDS * MAX_PLAYERS * UNIQUE_CARDS         |
+ * |                       |                                | card, player, tgt |
+ *
+ * For the combos, "card" is the card played 2 or 3 times (stored in
+ * Action::cards), player is arg1 and the target card arg2.
+ */
+using ActionCode = uint16_t;
+
+// Number of codes per action type, indexed by ActionEnum:
+constexpr std::array<size_t, UNIQUE_ACTIONS> ACTION_CODES_PER_TYPE = {
+    1,                                          // Draw
+    MAX_CARDS + 1,                              // Play_Defuse
+    1, 1, 1, 1, 1, 1,                           // Nope ... See_Future
+    MAX_PLAYERS,                                // Play_Favor
+    UNIQUE_CARDS,                               // Give_Favor
+    UNIQUE_CARDS * MAX_PLAYERS,                 // Play_Two_Card_Combo
+    UNIQUE_CARDS * MAX_PLAYERS * UNIQUE_CARDS   // Play_Three_Card_Combo
+};
+
+// First code of each action type, indexed by ActionEnum:
+constexpr std::array<size_t, UNIQUE_ACTIONS + 1> ACTION_CODE_OFFSETS = [] {
+    std::array<size_t, UNIQUE_ACTIONS + 1> offsets{};
+    for (size_t idx = 0; idx != UNIQUE_ACTIONS; ++idx)
+        offsets[idx + 1] = offsets[idx] + ACTION_CODES_PER_TYPE[idx];
+    return offsets;
+}();
+
+// Size of the flat action space (e.g. the number of policy logits).
+constexpr size_t NUM_ACTION_CODES = ACTION_CODE_OFFSETS[UNIQUE_ACTIONS];
+
+static_assert(NUM_ACTION_CODES <= UINT16_MAX, "Codes must fit an ActionCode.");
+
+/**
+ * @brief Maps an action to its code.
+ * @throws std::invalid_argument if the action has no code (e.g. args out of
+ * range, or a combo without 2 or 3 equal cards).
+ */
+ActionCode encode_action(Action const &a);
+
+/**
+ * @brief Maps a code back to the full action. A table lookup.
+ * @throws std::out_of_range if code >= NUM_ACTION_CODES.
+ */
+Action const &decode_action(ActionCode code);
+
+/**
+ * @brief Writes a legality mask over the flat action space: mask[code] is 1
+ * if the corresponding action is in legal, and 0 otherwise.
+ *
+ * @param legal Legal actions, e.g. from Rules::append_legal_actions.
+ * @param mask Output. Must have length NUM_ACTION_CODES.
+ * @throws std::invalid_argument if mask has the wrong length.
+ */
+void legal_action_mask(ActionList const &legal, std::span<uint8_t> mask);
+
+} // namespace exploding_kittens
+
+#endif // EK_ACTION_CODEC_H
\ No newline at end of file
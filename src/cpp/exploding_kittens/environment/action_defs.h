@@ -26,9 +26,14 @@ enum class ActionEnum : uint8_t {
     Give_Favor,                 // Args: card to give
 
     Play_Two_Card_Combo,        // Args: player to take card from
-    Play_Three_Card_Combo       // Args: player AND card
+    Play_Three_Card_Combo,      // Args: player AND card
+
+    Total                       // Number of elements. Always keep last!
 };
 
+// Number of unique action types in the Exploding Kittens game.
+constexpr size_t UNIQUE_ACTIONS = static_cast<size_t>(ActionEnum::Total);
+
 /**
  * @brief A struct that defines a specific action. It contains all the needed
  * information to describe the corresponding state change.
@@ -47,6 +52,8 @@ struct Action {
 
     /** @brief Argument 2: target card (for 3 card combo) */
     uint8_t arg2;
+
+    bool operator==(Action const &other) const = default;
 };
 
 // Defined in action_type.h:
@@ -0,0 +1,110 @@
+#ifndef EK_ACTION_LIST_H
+#define EK_ACTION_LIST_H
+
+#include "action_defs.h"
+#include "game_defs.h"
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+
+
+namespace exploding_kittens {
+
+// Largest number of legal actions in any state (of the implemented actions):
+// placing a kitten back, where there is one more position than cards.
+constexpr size_t MAX_LEGAL_ACTIONS = MAX_CARDS + 1;
+
+/**
+ * @brief A fixed-capacity list of actions that lives inline (e.g. on the
+ * stack), so legal action generation never touches the heap. Has the subset of
+ * the std::vector interface that the action generation code needs.
+ */
+class ActionList {
+
+    std::array<Action, MAX_LEGAL_ACTIONS> d_actions;
+    size_t d_size = 0;
+
+    public:
+        ActionList() = default;
+
+        /**
+         * @brief Append an action. Asserts there is room for it.
+         */
+        void push_back(Action const &a);
+
+        /**
+         * @brief Construct an action in place, with Action(args...).
+         */
+        template <typename ...Args>
+        Action &emplace_back(Args &&...args);
+
+        void clear();
+        size_t size() const;
+        bool empty() const;
+
+        Action &operator[](size_t idx);
+        Action const &operator[](size_t idx) const;
+        Action &back();
+
+        Action *begin();
+        Action *end();
+        Action const *begin() const;
+        Action const *end() const;
+};
+
+inline void ActionList::push_back(Action const &a) {
+    assert(d_size != MAX_LEGAL_ACTIONS && "ActionList capacity exceeded.");
+    d_actions[d_size++] = a;
+}
+
+template <typename ...Args>
+inline Action &ActionList::emplace_back(Args &&...args) {
+    assert(d_size != MAX_LEGAL_ACTIONS && "ActionList capacity exceeded.");
+    return d_actions[d_size++] = Action(std::forward<Args>(args)...);
+}
+
+inline void ActionList::clear() {
+    d_size = 0;
+}
+
+inline size_t ActionList::size() const {
+    return d_size;
+}
+
+inline bool ActionList::empty() const {
+    return d_size == 0;
+}
+
+inline Action &ActionList::operator[](size_t idx) {
+    return d_actions[idx];
+}
+
+inline Action const &ActionList::operator[](size_t idx) const {
+    return d_actions[idx];
+}
+
+inline Action &ActionList::back() {
+    return d_actions[d_size - 1];
+}
+
+inline Action *ActionList::begin() {
+    return d_actions.data();
+}
+
+inline Action *ActionList::end() {
+    return d_actions.data() + d_size;
+}
+
+inline Action const *ActionList::begin() const {
+    return d_actions.data();
+}
+
+inline Action const *ActionList::end() const {
+    return d_actions.data() + d_size;
+}
+
+} // namespace exploding_kittens
+
+#endif // EK_ACTION_LIST_H
\ No newline at end of file
@@ -2,7 +2,9 @@
 #define EK_ACTION_TYPE_H
 
 #include "action_defs.h"
+#include "action_list.h"
 #include "game_state.h"
+#include "undo_record.h"
 
 #include <vector>
 
@@ -15,6 +17,14 @@ namespace exploding_kittens {
  * These derivatives will implement logic for determining if an action is legal
  * (e.g. do you have the right cards for it), as well as for altering the game
  * state accordingly.
+ *
+ * The action types that Rules knows of keep that logic in static functions
+ * that take the game as a parameter:
+ *   static void legal_actions(GameState const &gs, ActionList &list);
+ *   static void apply(GameState &gs, Action const &a);
+ * Rules calls those directly for any game, and the virtual methods of the
+ * derived class only forward to them with their bound gs. Action types that
+ * support make/undo also have a static record (see Rules::make_action).
  */
 struct ActionType {
 
@@ -28,8 +38,14 @@ struct ActionType {
     
     /**
      * @brief Appends actions that are legal to take from the current game state.
+     * Does not allocate: the list has a fixed capacity.
      */
-    virtual void append_legal_actions(std::vector<Action> &vec) const = 0;
+    void append_legal_actions(ActionList &list) const;
+
+    /**
+     * @brief Convenience overload of the above, appending to a vector.
+     */
+    void append_legal_actions(std::vector<Action> &vec) const;
 
     /**
      * @brief Takes an action as input and alters the game state accordingly.
@@ -42,6 +58,10 @@ struct ActionType {
 
         ActionType(ActionEnum type, GameState &gs);
 
+        // The core logic of append_legal_actions. Should be implemented by
+        // each derived class.
+        virtual void do_append_legal_actions(ActionList &list) const = 0;
+
         // The core logic of take_action. Should be implemented by each derived
         // class.
         virtual void do_take_action(Action const &a) = 0;
@@ -53,6 +73,16 @@ inline ActionType::ActionType(ActionEnum type, GameState &gs)
     gs(gs)
 {}
 
+inline void ActionType::append_legal_actions(ActionList &list) const {
+    do_append_legal_actions(list);
+}
+
+inline void ActionType::append_legal_actions(std::vector<Action> &vec) const {
+    ActionList list;
+    do_append_legal_actions(list);
+    vec.insert(vec.end(), list.begin(), list.end());
+}
+
 inline void ActionType::take_action(Action const &a) {
     do_take_action(a);
 }
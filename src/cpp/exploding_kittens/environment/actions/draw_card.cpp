@@ -2,13 +2,26 @@
 
 namespace exploding_kittens {
 
-void DrawCard::append_legal_actions(std::vector<Action> &vec) const {
+void DrawCard::legal_actions(GameState const &gs, ActionList &list) {
     if (gs.state == State::Default)
-        vec.emplace_back(   // Braces guarantee zero-init for std::array:
+        list.emplace_back(   // Braces guarantee zero-init for std::array:
             ActionEnum::Draw, std::array<uint8_t, UNIQUE_CARDS>{}, 0U, 0U);
 }
 
-void DrawCard::do_take_action(Action const &a) {
+void DrawCard::record(GameState &gs, Action const &a, UndoRecord &undo) {
+    CardStack &deck = gs.cards.deck;
+    bool unresolved = deck.peek(0) == CardIdx::Unresolved;
+    deck.resolve_top(1, gs.rng);
+    uint8_t known_by = 0;
+    for (uint8_t player = 0; player != gs.num_players(); ++player)
+        known_by |= (deck.known_mask(player) >> (deck.size() - 1) & 1)
+                    << player;
+    undo.add_move(CardMove{deck.peek(0), PLACE_DECK, gs.primary_player, 0,
+                           known_by, unresolved});
+}
+
+void DrawCard::apply(GameState &gs, Action const &a) {
+    gs.cards.deck.resolve_top(1, gs.rng);   // Only does something if lazy.
     CardIdx i = gs.primary_hand().take_from(gs.cards.deck);
     if (i != CardIdx::Exploding_Kitten) {   // Normal card drawn.
         gs.register_turn();
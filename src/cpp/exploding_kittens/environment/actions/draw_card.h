@@ -15,9 +15,17 @@ class DrawCard: public ActionType {
     public:
         DrawCard(GameState &gs);
 
-        void append_legal_actions(std::vector<Action> &vec) const override;
+        // One Draw, in the Default state:
+        static void legal_actions(GameState const &gs, ActionList &list);
+        static void apply(GameState &gs, Action const &a);
+
+        // Adds the card move apply is going to make to undo. Resolves the
+        // top card of a lazy deck (as apply would) to know which it is:
+        static void record(GameState &gs, Action const &a, UndoRecord &undo);
 
     protected:
+        void do_append_legal_actions(ActionList &list) const override;
+
         void do_take_action(Action const &a) override;
 };
 
@@ -26,6 +34,14 @@ inline DrawCard::DrawCard(GameState &gs)
     ActionType(ActionEnum::Draw, gs)
 {}
 
+inline void DrawCard::do_append_legal_actions(ActionList &list) const {
+    legal_actions(gs, list);
+}
+
+inline void DrawCard::do_take_action(Action const &a) {
+    apply(gs, a);
+}
+
 } // namespace exploding_kittens
 
 #endif // EK_DRAW_CARD_H
\ No newline at end of file
@@ -1,13 +1,11 @@
 #include "nope_utils.h"
-
-#include "../../../utils.h"
+#include "../rules.h"
 
 #include <algorithm>
-#include <cassert>
 
 namespace exploding_kittens {
 
-void NopeableBase::do_take_action(Action const &a) {
+void NopeableBase::play(GameState &gs, Action const &a) {
     // Remove the cards from hand:
     for (size_t cIdx = 0; cIdx != a.cards.size(); ++cIdx) {
         for (uint8_t cards = a.cards[cIdx]; cards != 0; --cards)
@@ -19,7 +17,6 @@ void NopeableBase::do_take_action(Action const &a) {
     nopers_to_secondaries(gs);
     gs.is_noped = false;
     gs.staged_action = a;
-    gs.action_type = this;
 
     // No players that can nope: exit nope state directly:
     if (gs.secondary_players.size() == 0)
@@ -35,21 +32,16 @@ void nopers_to_secondaries(GameState &g) {
     }
 
     // Shuffle found players (for fairness -- else giving early index advantage)
-    std::shuffle(g.secondary_players.begin(), g.secondary_players.end(),
-        tabletop_general::randnum_gen);
+    std::shuffle(g.secondary_players.begin(), g.secondary_players.end(), g.rng);
 }
 
 void exit_nope_state(GameState &g) {
     g.state = State::Default;   // Might get overwritten by enforce_action.
     if (g.is_noped)
         return;
-    
-    assert(g.action_type != nullptr && "g.action_type can't be a null pointer.");
-    assert(g.action_type->type == g.staged_action.type
-        && "ActionType obj and staged action must have corresponding type.");
-    
+
     // Execute action if it wasn't noped
-    g.action_type->enforce_action(g.staged_action);
+    Rules::enforce_action(g, g.staged_action);
 }
 
 } // namespace exploding_kittens
\ No newline at end of file
@@ -14,7 +14,15 @@ namespace exploding_kittens {
 class NopeableBase: public ActionType {
 
     public:
-        using ActionType::ActionType;
+        // Also registers this object in gs.nopeables for the given type.
+        NopeableBase(ActionEnum type, GameState &gs);
+
+        /**
+         * @brief The shared first half of every nopeable action, for any game
+         * state: plays the cards in a.cards and enters the Nope state (or
+         * directly enforces a when nobody can nope).
+         */
+        static void play(GameState &gs, Action const &a);
     
     protected:
         // drops the cards and moves to nope state:
@@ -31,6 +39,7 @@ class NopeableBase: public ActionType {
 
         friend void nopers_to_secondaries(GameState &g);
         friend void exit_nope_state(GameState &g);
+        friend struct Rules;
 };
 
 /**
@@ -40,11 +49,22 @@ class NopeableBase: public ActionType {
 void nopers_to_secondaries(GameState &g);
 
 /**
- * @brief executes the pending action if g.is_noped is false. Then returns to
- * default state.
+ * @brief executes the pending action if g.is_noped is false (through
+ * Rules::enforce_action). Then returns to default state.
  */
 void exit_nope_state(GameState &g);
 
+inline NopeableBase::NopeableBase(ActionEnum type, GameState &gs)
+:
+    ActionType(type, gs)
+{
+    gs.nopeables[static_cast<size_t>(type)] = this;
+}
+
+inline void NopeableBase::do_take_action(Action const &a) {
+    play(gs, a);
+}
+
 } // namespace exploding_kittens
 
 #endif // EK_NOPE_UTILS_H
\ No newline at end of file
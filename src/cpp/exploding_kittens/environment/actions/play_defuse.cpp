@@ -1,8 +1,10 @@
 #include "play_defuse.h"
 
+#include <algorithm>
+
 namespace exploding_kittens {
 
-void PlayDefuse::append_legal_actions(std::vector<Action> &vec) const {
+void PlayDefuse::legal_actions(GameState const &gs, ActionList &list) {
     if (gs.state != State::Defuse)
         return;
     
@@ -19,15 +21,25 @@ void PlayDefuse::append_legal_actions(std::vector<Action> &vec) const {
     uint8_t max_depth = gs.cards.deck.size();
     for (uint8_t d = 0U; d <= max_depth; ++d) {
         act.arg1 = d;
-        vec.push_back(act);
+        list.push_back(act);
     }
 }
 
-void PlayDefuse::do_take_action(Action const &a) {
+void PlayDefuse::record(GameState &gs, Action const &a,
+                        UndoRecord &undo) {
+    uint8_t depth = std::min<size_t>(a.arg1, gs.cards.deck.size());
+    undo.add_move(CardMove{CardIdx::Defuse, gs.primary_player,
+                           PLACE_DISCARD_PILE, 0, 0, false});
+    undo.add_move(CardMove{CardIdx::Exploding_Kitten, gs.primary_player,
+                           PLACE_DECK, depth, 0, false});
+}
+
+void PlayDefuse::apply(GameState &gs, Action const &a) {
     // Move cards around:
     size_t depth = a.arg1;
     gs.primary_hand().place_at(gs.cards.discard_pile, CardIdx::Defuse);
     gs.primary_hand().place_at(gs.cards.deck, CardIdx::Exploding_Kitten, depth);
+    gs.cards.deck.reveal(gs.primary_player, depth);     // Only they know.
     gs.state = State::Default;
 
     // I still need to register the turn:
@@ -15,9 +15,16 @@ class PlayDefuse: public ActionType {
     public:
         PlayDefuse(GameState &gs);
 
-        void append_legal_actions(std::vector<Action> &vec) const override;
+        // One per depth the kitten can go back at, in the Defuse state:
+        static void legal_actions(GameState const &gs, ActionList &list);
+        static void apply(GameState &gs, Action const &a);
+
+        // Adds the card moves apply is going to make to undo:
+        static void record(GameState &gs, Action const &a, UndoRecord &undo);
 
     protected:
+        void do_append_legal_actions(ActionList &list) const override;
+
         // Place back an exploding kitten at depth specified by arg1.
         void do_take_action(Action const &a) override;
 };
@@ -27,6 +34,14 @@ inline PlayDefuse::PlayDefuse(GameState &gs)
     ActionType(ActionEnum::Play_Defuse, gs)
 {}
 
+inline void PlayDefuse::do_append_legal_actions(ActionList &list) const {
+    legal_actions(gs, list);
+}
+
+inline void PlayDefuse::do_take_action(Action const &a) {
+    apply(gs, a);
+}
+
 } // namespace exploding_kittens
 
 #endif // EK_PLAY_DEFUSE_H
\ No newline at end of file
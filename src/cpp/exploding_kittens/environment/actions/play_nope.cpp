@@ -5,7 +5,7 @@
 
 namespace exploding_kittens {
 
-void PlayNope::append_legal_actions(std::vector<Action> &vec) const {
+void PlayNope::legal_actions(GameState const &gs, ActionList &list) {
     // WARNING: not checking if current secondary player has a nope because
     // we wouldn't get here if not. (See nope_utils.cpp:nopers_to_secondaries).
     // Only asserting if this holds at debug time:
@@ -16,12 +16,17 @@ void PlayNope::append_legal_actions(std::vector<Action> &vec) const {
         // Braces guarantee zero-init for std::array:
         std::array<uint8_t, UNIQUE_CARDS> cards = {};
         cards[to_uint(CardIdx::Nope)] = 1U;
-        vec.emplace_back(
+        list.emplace_back(
             ActionEnum::Play_Nope, cards, 0U, 0U);
     }
 }
 
-void PlayNope::do_take_action(Action const &a) {
+void PlayNope::record(GameState &gs, Action const &a, UndoRecord &undo) {
+    undo.add_move(CardMove{CardIdx::Nope, gs.secondary_players.back(),
+                           PLACE_DISCARD_PILE, 0, 0, false});
+}
+
+void PlayNope::apply(GameState &gs, Action const &a) {
     assert(gs.secondary_hand().has(CardIdx::Nope) &&
         "No safety checks: player should have nope.");
     
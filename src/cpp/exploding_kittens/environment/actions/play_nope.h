@@ -17,9 +17,16 @@ class PlayNope: public ActionType {
     public:
         PlayNope(GameState &gs);
 
-        void append_legal_actions(std::vector<Action> &vec) const override;
+        // Offered to the secondary player in the Nope state:
+        static void legal_actions(GameState const &gs, ActionList &list);
+        static void apply(GameState &gs, Action const &a);
+
+        // Adds the card move apply is going to make to undo:
+        static void record(GameState &gs, Action const &a, UndoRecord &undo);
 
     protected:
+        void do_append_legal_actions(ActionList &list) const override;
+
         // Negate the nope flag and again give everyone a chance to nope:
         void do_take_action(Action const &a) override;
 };
@@ -29,6 +36,14 @@ inline PlayNope::PlayNope(GameState &gs)
     ActionType(ActionEnum::Play_Nope, gs)
 {}
 
+inline void PlayNope::do_append_legal_actions(ActionList &list) const {
+    legal_actions(gs, list);
+}
+
+inline void PlayNope::do_take_action(Action const &a) {
+    apply(gs, a);
+}
+
 } // namespace exploding_kittens
 
 #endif // EK_PLAY_NOPE_H
\ No newline at end of file
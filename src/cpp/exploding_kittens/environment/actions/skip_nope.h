@@ -14,9 +14,12 @@ class SkipNope: public ActionType {
     public:
         SkipNope(GameState &gs);
 
-        void append_legal_actions(std::vector<Action> &vec) const override;
+        static void legal_actions(GameState const &gs, ActionList &list);
+        static void apply(GameState &gs, Action const &a);
 
     protected:
+        void do_append_legal_actions(ActionList &list) const override;
+
         // Move on to the next player that can nope, or exit nope state:
         void do_take_action(Action const &a) override;
 };
@@ -26,6 +29,14 @@ inline SkipNope::SkipNope(GameState &gs)
     ActionType(ActionEnum::Skip_Nope, gs)
 {}
 
+inline void SkipNope::do_append_legal_actions(ActionList &list) const {
+    legal_actions(gs, list);
+}
+
+inline void SkipNope::do_take_action(Action const &a) {
+    apply(gs, a);
+}
+
 } // namespace exploding_kittens
 
 #endif // EK_SKIP_NOPE_H
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include "batch_environment.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace exploding_kittens {
+
+BatchEnvironment::BatchEnvironment(size_t num_games, size_t num_players,
+                                   uint64_t seed, bool auto_reset)
+:
+    d_num_players(num_players),
+    d_auto_reset(auto_reset),
+    d_games(num_games, num_players, seed)
+{}
+
+void BatchEnvironment::reset(BatchOutputs const &out) {
+    check(out);
+    d_games.reset();
+    std::fill(out.rewards.begin(), out.rewards.end(), 0.0f);
+    std::fill(out.dones.begin(), out.dones.end(), 0);
+    write(out);
+}
+
+void BatchEnvironment::step(std::span<ActionCode const> actions,
+                            BatchOutputs const &out) {
+    check(out);
+    if (actions.size() != size())
+        throw std::invalid_argument("Need exactly one action per game.");
+
+    // All actions are checked before any game is stepped:
+    ActionList legal;
+    for (size_t idx = 0; idx != size(); ++idx) {
+        if (d_games.states()[idx] == State::Game_Over)
+            continue;
+        Action const &a = decode_action(actions[idx]);
+        legal.clear();
+        d_games.append_legal_actions(idx, legal);
+        if (std::find(legal.begin(), legal.end(), a) == legal.end())
+            throw std::invalid_argument("Illegal action for game " +
+                                        std::to_string(idx) + ".");
+    }
+
+    std::fill(out.rewards.begin(), out.rewards.end(), 0.0f);
+    for (size_t idx = 0; idx != size(); ++idx) {
+        if (d_games.states()[idx] == State::Game_Over) {
+            out.dones[idx] = 1;
+            continue;
+        }
+        d_games.step(idx, decode_action(actions[idx]));
+        out.dones[idx] = d_games.states()[idx] == State::Game_Over;
+        if (not out.dones[idx])
+            continue;
+
+        uint8_t winner = d_games[idx].winner();
+        for (size_t player = 0; player != d_num_players; ++player)
+            out.rewards[idx * d_num_players + player] =
+                player == winner ? 1.0f : -1.0f;
+        if (d_auto_reset)
+            d_games.reset(idx);
+    }
+    write(out);
+}
+
+void BatchEnvironment::check(BatchOutputs const &out) const {
+    if (out.observations.size() != size() * OBS_SIZE or
+            out.rewards.size() != size() * d_num_players or
+            out.dones.size() != size() or
+            out.agents.size() != size() or
+            out.masks.size() != size() * NUM_ACTION_CODES)
+        throw std::invalid_argument("Output buffers have the wrong size.");
+}
+
+void BatchEnvironment::write(BatchOutputs const &out) const {
+    d_games.observations(out.observations);
+    d_games.legal_action_masks(out.masks);
+    std::copy(d_games.acting_players().begin(),
+        d_games.acting_players().end(), out.agents.begin());
+}
+
+} // namespace exploding_kittens
\ No newline at end of file
@@ -0,0 +1,124 @@
+#ifndef EK_BATCH_ENVIRONMENT_H
+#define EK_BATCH_ENVIRONMENT_H
+
+#include "vector_game_state.h"
+#include "action_codec.h"
+#include "observation.h"
+
+#include <cstdint>
+#include <span>
+
+
+namespace exploding_kittens {
+
+/**
+ * @brief Caller-owned output buffers of a BatchEnvironment, for N games with
+ * P players each. Row idx of every buffer belongs to game idx.
+ */
+struct BatchOutputs {
+    std::span<float> observations;  // N * OBS_SIZE, for the acting players.
+    std::span<float> rewards;       // N * P: +1 for the winner and -1 for the
+                                    // others on the step that ends a game,
+                                    // 0 otherwise.
+    std::span<uint8_t> dones;       // N: 1 if the game is over (or, with
+                                    // auto-reset, ended in this step).
+    std::span<uint8_t> agents;      // N: the acting player of every game.
+    std::span<uint8_t> masks;       // N * NUM_ACTION_CODES, legality masks
+                                    // for the acting players.
+};
+
+/**
+ * @brief A VectorGameState as a reinforcement learning environment: actions
+ * come in as codes of the flat action space, and everything a learner needs
+ * afterwards gets written straight into caller-provided buffers. Nothing is
+ * allocated per step, so the buffers can be e.g. NumPy arrays that are reused
+ * for the whole run.
+ *
+ * With auto-reset, a game that ends in a step is reset right away (after
+ * writing its rewards and done flag), so the observations, masks and agents
+ * of that game are already those of the new game. A vectorized rollout then
+ * never has to stop for resets.
+ */
+class BatchEnvironment {
+
+    size_t d_num_players;
+    bool d_auto_reset;
+    VectorGameState d_games;
+
+    public:
+        /**
+         * @brief Creates num_games games (see VectorGameState).
+         * @param auto_reset Whether finished games get reset by step.
+         * @throws std::invalid_argument if num_players too large or small.
+         */
+        BatchEnvironment(size_t num_games, size_t num_players,
+                         uint64_t seed = 0, bool auto_reset = false);
+
+        /**
+         * @return The number of games in the batch.
+         */
+        size_t size() const;
+
+        /**
+         * @return The number of players in each game.
+         */
+        size_t num_players() const;
+
+        /**
+         * @return Whether finished games get reset by step.
+         */
+        bool auto_reset() const;
+
+        /**
+         * @brief Start a new game in every game of the batch, and write the
+         * first observations and masks (rewards and dones become zero).
+         * @throws std::invalid_argument if a buffer has the wrong length.
+         */
+        void reset(BatchOutputs const &out);
+
+        /**
+         * @brief Take one action in every game and write the results. Games
+         * that were already over (only without auto-reset) ignore their
+         * action.
+         *
+         * @param actions One action code per game. Must have length size().
+         * @throws std::invalid_argument if a buffer has the wrong length, or
+         * an action is illegal in its game (see the masks). Then no game is
+         * stepped.
+         * @throws std::out_of_range for codes >= NUM_ACTION_CODES.
+         */
+        void step(std::span<ActionCode const> actions,
+                  BatchOutputs const &out);
+
+        /**
+         * @brief The games themselves, e.g. for inspection.
+         */
+        VectorGameState const &games() const;
+
+    private:
+        // Throws if a buffer of out has the wrong length.
+        void check(BatchOutputs const &out) const;
+
+        // Writes the observations, masks and agents of all games.
+        void write(BatchOutputs const &out) const;
+};
+
+inline size_t BatchEnvironment::size() const {
+    return d_games.size();
+}
+
+inline size_t BatchEnvironment::num_players() const {
+    return d_num_players;
+}
+
+inline bool BatchEnvironment::auto_reset() const {
+    return d_auto_reset;
+}
+
+inline VectorGameState const &BatchEnvironment::games() const {
+    return d_games;
+}
+
+} // namespace exploding_kittens
+
+#endif // EK_BATCH_ENVIRONMENT_H
\ No newline at end of file
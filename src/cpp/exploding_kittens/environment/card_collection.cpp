@@ -2,39 +2,34 @@
 
 #include "../../utils.h"
 
-#include <numeric>
-#include <random>
 #include <stdexcept>
 
 namespace exploding_kittens
 {
 
-CardIdx CardCollection::random_card() const {
-    
-    // Getting the total number of cards so we can give each an index:
-    size_t total_cards = std::accumulate(
-        d_card_counts.begin(), d_card_counts.end(), 0);
+CardIdx CardCollection::random_card(tabletop_general::Rng &rng) const {
+    uint32_t total_cards = count_total(d_card_counts.data());
     if (total_cards == 0)
         return CardIdx::Error;
-
-    // Getting a random index to pick:
-    size_t rand_num = std::uniform_int_distribution(0UL, total_cards - 1)(
-        tabletop_general::randnum_gen);
-    
-    // Seeing which card belongs to said index:
-    uint8_t i = 0; uint8_t h = has(i);
-    while (rand_num >= h) {
-        rand_num -= h;
-        h = has(++i);
-    }
-    return from_uint(i);
+    return from_uint(
+        count_sample(d_card_counts.data(), rng.below(total_cards)));
 }
 
 bool CardCollection::base_remove(CardIdx i) {
-    if (d_card_counts[to_uint(i)] == 0)
+    uint8_t &count = d_card_counts[to_uint(i)];
+    if (count == 0)
         return false;
-    --d_card_counts[to_uint(i)];
+    d_counts_hash ^= ZobristKeys::count(to_uint(i), count) ^
+                     ZobristKeys::count(to_uint(i), count - 1);
+    --count;
     return true;
 }
 
+uint64_t CardCollection::compute_counts_hash() const {
+    uint64_t hash = 0;
+    for (size_t i = 0; i != UNIQUE_CARDS; ++i)
+        hash ^= ZobristKeys::count(i, d_card_counts[i]);
+    return hash;
+}
+
 } // namespace exploding_kittens
\ No newline at end of file
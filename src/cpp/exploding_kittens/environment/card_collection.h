@@ -2,6 +2,9 @@
 #define EK_CARD_COLLECTION_H
 
 #include "card_defs.h"
+#include "count_kernels.h"
+#include "zobrist_keys.h"
+#include "../../utils.h"
 
 #include <cstdint>
 #include <array>
@@ -15,8 +18,12 @@ namespace exploding_kittens {
  */
 class CardCollection {
 
-    // For each card, specifies how many there are in this collection.
-    std::array<uint8_t, UNIQUE_CARDS> d_card_counts;
+    // For each card, specifies how many there are in this collection. Padded
+    // with zeros to COUNTS_WIDTH bytes for the vectorized count kernels.
+    alignas(COUNTS_WIDTH) std::array<uint8_t, COUNTS_WIDTH> d_card_counts{};
+
+    // Zobrist hash of d_card_counts. Kept up to date by base_insert/remove.
+    uint64_t d_counts_hash = 0;
 
     public:
         
@@ -39,8 +46,36 @@ class CardCollection {
          * @return The data inside the d_card_counts span (i.e. span::data())
          * @todo Maybe change to something other than a pointer later on, like a
          * span
+         * @warning Call rehash() after writing through this pointer. Only
+         * write the first UNIQUE_CARDS entries: the padding must stay zero.
          */
         uint8_t *counts();
+        uint8_t const *counts() const;
+
+        /**
+         * @return The total number of cards in the collection.
+         */
+        size_t total() const;
+
+        /**
+         * @return A bitmask with bit i set if the collection has card i.
+         */
+        uint16_t nonzero_mask() const;
+
+        /**
+         * @return The Zobrist hash of the counts. Maintained incrementally.
+         */
+        uint64_t counts_hash() const;
+
+        /**
+         * @return The Zobrist hash of the counts, computed from scratch.
+         */
+        uint64_t compute_counts_hash() const;
+
+        /**
+         * @brief Recompute the hash after the counts got altered directly.
+         */
+        void rehash();
     
     protected:
         /**
@@ -58,8 +93,10 @@ class CardCollection {
         /**
          * @brief Returns a random card (probabilities proportional to counts).
          * If empty, returns CardIdx::Error.
+         *
+         * @param rng The generator to draw randomness from.
          */
-        CardIdx random_card() const;
+        CardIdx random_card(tabletop_general::Rng &rng) const;
 
         friend class Cards;
 };
@@ -76,8 +113,31 @@ inline uint8_t *CardCollection::counts() {
     return d_card_counts.data();
 }
 
+inline uint8_t const *CardCollection::counts() const {
+    return d_card_counts.data();
+}
+
+inline size_t CardCollection::total() const {
+    return count_total(d_card_counts.data());
+}
+
+inline uint16_t CardCollection::nonzero_mask() const {
+    return count_nonzero_mask(d_card_counts.data());
+}
+
+inline uint64_t CardCollection::counts_hash() const {
+    return d_counts_hash;
+}
+
+inline void CardCollection::rehash() {
+    d_counts_hash = compute_counts_hash();
+}
+
 inline void CardCollection::base_insert(CardIdx i) {
-    ++d_card_counts[to_uint(i)];
+    uint8_t &count = d_card_counts[to_uint(i)];
+    d_counts_hash ^= ZobristKeys::count(to_uint(i), count) ^
+                     ZobristKeys::count(to_uint(i), count + 1);
+    ++count;
 }
 
 } // namespace exploding_kittens
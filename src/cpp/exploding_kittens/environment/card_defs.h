@@ -29,7 +29,9 @@ enum class CardIdx : uint8_t {
     Cat_5,
 
     Total,              // Number of elements. Always keep after last card!
-    Error               // Error card: give on failure.
+    Error,              // Error card: give on failure.
+    Unresolved          // A lazy deck position that has no card drawn for
+                        // it yet (see CardStack::set_lazy).
 };
 
 /**
@@ -11,6 +11,12 @@ CardIdx CardHand::take_from(CardStack &stack) {
     return i;
 }
 
+CardIdx CardHand::take_from(CardStack &stack, size_t depth) {
+    CardIdx i = stack.remove(depth);
+    base_insert(i);
+    return i;
+}
+
 CardIdx CardHand::take_from(CardHand &other, CardIdx i) {
     if (other.base_remove(i)) {
         base_insert(i);
@@ -19,8 +25,8 @@ CardIdx CardHand::take_from(CardHand &other, CardIdx i) {
     return CardIdx::Error;
 }
 
-CardIdx CardHand::take_from(CardHand &other) {
-    CardIdx i = other.random_card();
+CardIdx CardHand::take_from(CardHand &other, tabletop_general::Rng &rng) {
+    CardIdx i = other.random_card(rng);
     if (i != CardIdx::Error)
         return take_from(other, i);
     return i;
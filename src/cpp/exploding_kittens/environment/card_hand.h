@@ -21,8 +21,18 @@ class CardHand: public CardCollection {
          * 
          * @param stack Stack (i.e. deck or discard pile) to take from.
          * @return The card that was taken.
+         * @throws std::logic_error if the top of a lazy stack is unresolved.
          */
         CardIdx take_from(CardStack &stack);
+
+        /**
+         * @brief Take the card at some depth from a stack.
+         *
+         * @param stack Stack to take from.
+         * @param depth The CardStack::remove's depth parameter.
+         * @return The card that was taken.
+         */
+        CardIdx take_from(CardStack &stack, size_t depth);
         
         /**
          * @brief Take a specified card from another player
@@ -37,9 +47,10 @@ class CardHand: public CardCollection {
          * @brief Take a random card from another player.
          * 
          * @param other The hand of the other player.
+         * @param rng The generator used to pick the card.
          * @return CardIdx The card you ended up picking, or CardIdx::Error.
          */
-        CardIdx take_from(CardHand &other);
+        CardIdx take_from(CardHand &other, tabletop_general::Rng &rng);
 
         /**
          * @brief Place a card on top of a stack.
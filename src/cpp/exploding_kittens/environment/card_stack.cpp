@@ -1,36 +1,157 @@
 #include "card_stack.h"
 
+#include <algorithm>
 #include <stdexcept>
 
 namespace exploding_kittens {
 
 CardIdx CardStack::pop() {
-    if (d_ordered.empty())
+    if (d_size == 0)
         throw std::out_of_range("Tried to pop from empty card stack.");
-    CardIdx ret = d_ordered.back();
+    if (d_ordered[d_size - 1] == CardIdx::Unresolved)
+        throw std::logic_error("Resolve the top card before popping it.");
+    CardIdx ret = d_ordered[--d_size];
     base_remove(ret);
-    d_ordered.pop_back();
+    d_order_hash ^= ZobristKeys::position(d_size, ret);
+    for (uint64_t &known : d_known)
+        known &= ~(1ULL << d_size);
     return ret;
 }
 
 void CardStack::ordered_from_data()
 {
-    d_ordered.clear();
+    size_t total = 0;
     for (uint8_t i = 0; i != UNIQUE_CARDS; ++i)
-        d_ordered.insert(d_ordered.end(), has(i), from_uint(i));
+        total += has(i);
+    if (total > MAX_CARDS)
+        throw std::length_error("Too many cards for a card stack.");
+
+    d_size = 0;
+    for (uint8_t i = 0; i != UNIQUE_CARDS; ++i)
+        for (uint8_t n = 0; n != has(i); ++n)
+            d_ordered[d_size++] = from_uint(i);
+    d_known.fill(0);
+    CardCollection::rehash();
+    if (d_lazy)
+        unresolve_all();
+    else
+        d_order_hash = positions_hash();
+}
+
+void CardStack::set_lazy(bool lazy) {
+    if (not lazy and std::find(d_ordered.begin(), d_ordered.begin() + d_size,
+                               CardIdx::Unresolved) != d_ordered.begin() + d_size)
+        throw std::logic_error("Resolve all positions before leaving lazy "
+                               "mode.");
+    d_lazy = lazy;
+}
+
+void CardStack::unresolve_all() {
+    std::fill_n(d_ordered.begin(), d_size, CardIdx::Unresolved);
+    std::copy_n(counts(), COUNTS_WIDTH, d_unresolved.begin());
+    d_order_hash = 0;
 }
 
 void CardStack::insert(CardIdx i, size_t depth) {
+    assert(d_size != MAX_CARDS && "Card stack is full.");
     base_insert(i);
-    auto position = depth > d_ordered.size() ? d_ordered.begin() :
-        (d_ordered.end() - depth);
-    d_ordered.insert(position, i);
+    size_t pos = depth > d_size ? 0 : d_size - depth;
+
+    // Every card above the new one moves up a position. That is O(n) in any
+    // layout, as the Zobrist hash keys each card on its position: every card
+    // that moves has to be re-keyed anyway.
+    for (size_t above = d_size; above != pos; --above) {
+        CardIdx c = d_ordered[above - 1];
+        d_ordered[above] = c;
+        if (c != CardIdx::Unresolved)
+            d_order_hash ^= ZobristKeys::position(above - 1, c) ^
+                            ZobristKeys::position(above, c);
+    }
+    d_ordered[pos] = i;
+    d_order_hash ^= ZobristKeys::position(pos, i);
+    ++d_size;
+
+    // Known cards at or above pos moved up too (the new card is unknown):
+    uint64_t below = (1ULL << pos) - 1;
+    for (uint64_t &known : d_known)
+        known = (known & below) | ((known & ~below) << 1);
+}
+
+void CardStack::forget_unknown() {
+    uint64_t known = 0;
+    for (uint64_t mask : d_known)
+        known |= mask;
+    for (size_t pos = 0; pos != d_size; ++pos)
+        if ((known >> pos & 1) == 0)
+            d_ordered[pos] = CardIdx::Unresolved;
+    d_lazy = true;
+    rehash();
+}
+
+CardIdx CardStack::remove(size_t depth) {
+    assert(depth < d_size && "Removing below the bottom of the stack.");
+    size_t pos = d_size - 1 - depth;
+    CardIdx ret = d_ordered[pos];
+    if (ret == CardIdx::Unresolved)
+        throw std::logic_error("Resolve the card before removing it.");
+    base_remove(ret);
+    d_order_hash ^= ZobristKeys::position(pos, ret);
+
+    // Every card above the removed one moves down a position:
+    for (size_t above = pos + 1; above != d_size; ++above) {
+        CardIdx c = d_ordered[above];
+        d_ordered[above - 1] = c;
+        if (c != CardIdx::Unresolved)
+            d_order_hash ^= ZobristKeys::position(above, c) ^
+                            ZobristKeys::position(above - 1, c);
+    }
+    --d_size;
+
+    // Known cards above pos moved down too, the bit of pos goes:
+    uint64_t below = (1ULL << pos) - 1;
+    for (uint64_t &known : d_known)
+        known = (known & below) | ((known >> 1) & ~below);
+    return ret;
+}
+
+void CardStack::unresolve_top() {
+    assert(d_lazy and d_size != 0 and
+           d_ordered[d_size - 1] != CardIdx::Unresolved &&
+           "Can only unresolve a resolved top card of a lazy stack.");
+    CardIdx &top = d_ordered[d_size - 1];
+    d_order_hash ^= ZobristKeys::position(d_size - 1, top);
+    ++d_unresolved[to_uint(top)];
+    top = CardIdx::Unresolved;
+}
+
+uint64_t CardStack::compute_order_hash() const {
+    return d_lazy ? positions_hash() ^ compute_counts_hash() :
+        positions_hash();
+}
+
+uint64_t CardStack::positions_hash() const {
+    uint64_t hash = 0;
+    for (size_t pos = 0; pos != d_size; ++pos)
+        if (d_ordered[pos] != CardIdx::Unresolved)
+            hash ^= ZobristKeys::position(pos, d_ordered[pos]);
+    return hash;
+}
+
+void CardStack::rehash() {
+    CardCollection::rehash();
+    d_order_hash = positions_hash();
+
+    d_unresolved = {};
+    std::copy_n(counts(), UNIQUE_CARDS, d_unresolved.begin());
+    for (size_t pos = 0; pos != d_size; ++pos)
+        if (d_ordered[pos] != CardIdx::Unresolved)
+            --d_unresolved[to_uint(d_ordered[pos])];
 }
 
 std::span<CardIdx> CardStack::get_top_n(size_t n) {
-    auto begin = n > d_ordered.size() ? d_ordered.begin() :
-        (d_ordered.end() - n);
-    return std::span<CardIdx>(begin, d_ordered.end());
+    size_t begin = n > d_size ? 0 : d_size - n;
+    return std::span<CardIdx>(d_ordered.begin() + begin,
+        d_ordered.begin() + d_size);
 }
 
 } // namespace exploding_kittens
\ No newline at end of file
@@ -2,39 +2,122 @@
 #define EK_CARD_STACK_H
 
 #include "card_collection.h"
+#include "game_defs.h"
 #include "../../utils.h"
 
+#include <array>
+#include <cassert>
 #include <cstdint>
-#include <vector>
 #include <span>
 #include <algorithm>
 
 namespace exploding_kittens {
 
+static_assert(MAX_CARDS <= 64, "Known positions of a stack must fit 64 bits.");
+
 /**
- * @brief An ordered CardCollection, such as the deck and discard pile.
+ * @brief An ordered CardCollection, such as the deck and discard pile. The
+ * order lives inline in a fixed-capacity array (no stack ever holds more than
+ * MAX_CARDS cards), so a stack never allocates and is cheap to copy.
+ *
+ * A stack can be lazy: shuffling it then only forgets the order, and the card
+ * at a position gets drawn from the remaining cards when it is needed (see
+ * resolve_top). Until a card gets looked at, it could have been any of them,
+ * so this gives the same distribution of games as shuffling up front, while
+ * shuffles become O(1) and cards that never get drawn cost no randomness.
+ * Cards placed at a position (e.g. a kitten put back) are resolved.
  */
 class CardStack: public CardCollection {
     
     // An ordered representation of d_card_counts. They should always agree.
-    std::vector<CardIdx> d_ordered;
+    // Index 0 is the bottom; only the first d_size entries are in use.
+    std::array<CardIdx, MAX_CARDS> d_ordered;
+    uint8_t d_size = 0;
+
+    // Zobrist hash of d_ordered. Kept up to date by all methods below.
+    uint64_t d_order_hash = 0;
+
+    // Lazy mode: positions can hold CardIdx::Unresolved, and d_unresolved
+    // holds the cards they will be drawn from (the counts minus the cards at
+    // resolved positions). Zobrist keys are only used for resolved positions.
+    bool d_lazy = false;
+    alignas(COUNTS_WIDTH) std::array<uint8_t, COUNTS_WIDTH> d_unresolved{};
+
+    // Per player, bit i set if the player knows which card is at index i.
+    // Bits at or above d_size are always zero. Cards keep being known when
+    // cards move around them, until the stack gets shuffled.
+    std::array<uint64_t, MAX_PLAYERS> d_known{};
     
     public:
         using CardCollection::CardCollection;
         
+        /**
+         * @brief Switch lazy mode on or off. Takes effect at the next
+         * ordered_from_data or shuffle (e.g. when starting a new game).
+         * @throws std::logic_error if switching it off while positions are
+         * unresolved (resolve them all with resolve_top first).
+         */
+        void set_lazy(bool lazy);
+
+        /**
+         * @return Whether the stack is in lazy mode.
+         */
+        bool is_lazy() const;
+
+        /**
+         * @brief Draw the cards for the unresolved positions among the top n
+         * (all, if n is larger than the stack). Does nothing if not lazy.
+         * Needed before pop, peek and get_top_n on a lazy stack.
+         */
+        void resolve_top(size_t n, tabletop_general::Rng &rng);
+
+        /**
+         * @brief Resolve the top position to a given card, instead of a
+         * random one (e.g. to step through every possible draw). The top
+         * should be unresolved and the card among unresolved_counts()
+         * (asserted).
+         */
+        void resolve_top_as(CardIdx card);
+
+        /**
+         * @brief Switch to lazy mode, and unresolve every position that no
+         * player knows (see known_mask): their order gets forgotten, so that
+         * drawing them becomes a chance event again (see Rules::chance_event).
+         * For planners, on their own copy of a game.
+         */
+        void forget_unknown();
+
+        /**
+         * @return Per card, how many the unresolved positions hold. Padded
+         * to COUNTS_WIDTH like the counts. All zero if not lazy.
+         */
+        uint8_t const *unresolved_counts() const;
+
+        /**
+         * @brief The inverse of resolving the top card: it becomes unresolved
+         * again (for taking back a draw). The stack should be lazy and the top
+         * card resolved (asserted).
+         */
+        void unresolve_top();
+
         /**
          * @brief Computes a valid state of d_ordered from its d_card_counts.
+         * In lazy mode, all positions become unresolved.
          * @note Note that shuffle() has to be called afterwards still!
+         * @throws std::length_error if there are more than MAX_CARDS cards.
          */
         void ordered_from_data();
 
         /**
          * @brief Shuffle the cards randomly.
+         *
+         * @param rng The generator to draw randomness from.
          */
-        void shuffle();
+        void shuffle(tabletop_general::Rng &rng);
 
         /**
-         * @param i Card to be placed on top of the stack.
+         * @param i Card to be placed on top of the stack. The stack should not
+         * be full (asserted).
          */
         void push(CardIdx i);
 
@@ -43,6 +126,8 @@ class CardStack: public CardCollection {
          * 
          * @return The removed card.
          * @throws std::out_of_range if stack is empty.
+         * @throws std::logic_error if the top is unresolved (see
+         * resolve_top).
          */
         CardIdx pop();
 
@@ -53,14 +138,47 @@ class CardStack: public CardCollection {
          * @param depth The location: 0 means place on top, 1 means place
          * under top card, etc.
          * @note if depth is larger than pile size, card gets placed on the bottom.
+         * The stack should not be full (asserted).
          */
         void insert(CardIdx i, size_t depth);
+
+        /**
+         * @brief Remove the card at depth (0 is the top card): the inverse of
+         * insert, including which cards the players know. Depth should be
+         * smaller than size() (asserted).
+         *
+         * @return The removed card.
+         * @throws std::logic_error if the position is unresolved.
+         */
+        CardIdx remove(size_t depth);
         
+        /**
+         * @return The card at depth (0 is the top card), which is
+         * CardIdx::Unresolved for an unresolved position of a lazy stack.
+         * Depth should be smaller than size() (asserted).
+         */
+        CardIdx peek(size_t depth) const;
+
+        /**
+         * @brief Let player know which card is at depth (0 is the top card,
+         * and larger depths than the stack mean the bottom, as for insert).
+         * E.g. after placing an exploding kitten back, or seeing the future.
+         */
+        void reveal(uint8_t player, size_t depth);
+
+        /**
+         * @return Bit i is set if player knows the card at index i (counted
+         * from the bottom, so the top card is bit size() - 1).
+         */
+        uint64_t known_mask(uint8_t player) const;
+
         /**
          * @brief Get the n cards from the top of the stack.
          * 
          * @param n Number of cards to get from the top of the stack.
-         * @return A span that provides a view into the vector.
+         * @return A span that provides a view into the stack.
+         * @warning Call rehash() after reordering cards through it. Lazy
+         * stacks can have unresolved positions in there (see resolve_top).
          */
         std::span<CardIdx> get_top_n(size_t n);
 
@@ -69,22 +187,104 @@ class CardStack: public CardCollection {
          */
         size_t size() const;
 
-        friend class GameState;
+        /**
+         * @return The Zobrist hash of the card order (which determines the
+         * counts too). Maintained incrementally: push and pop cost one xor,
+         * insert one per card above the inserted one, shuffle a recompute.
+         * In lazy mode, the hash of the resolved positions and the counts.
+         */
+        uint64_t order_hash() const;
+
+        /**
+         * @return The Zobrist hash of the card order, computed from scratch.
+         */
+        uint64_t compute_order_hash() const;
+
+        /**
+         * @brief Recompute both hashes (and the cards left for unresolved
+         * positions) after the data got altered directly.
+         */
+        void rehash();
+
+    private:
+        // Xor of the position keys of all resolved positions.
+        uint64_t positions_hash() const;
+
+        // Mark all positions unresolved.
+        void unresolve_all();
+
+        friend struct GameState;
 };
 
-inline void CardStack::shuffle()
+inline void CardStack::shuffle(tabletop_general::Rng &rng)
 {
-    std::shuffle(d_ordered.begin(), d_ordered.end(),
-        tabletop_general::randnum_gen);
+    if (d_lazy)
+        unresolve_all();
+    else {
+        std::shuffle(d_ordered.begin(), d_ordered.begin() + d_size, rng);
+        d_order_hash = positions_hash();
+    }
+    d_known.fill(0);
+}
+
+inline bool CardStack::is_lazy() const {
+    return d_lazy;
 }
 
 inline void CardStack::push(CardIdx i) {
+    assert(d_size != MAX_CARDS && "Card stack is full.");
     base_insert(i);
-    d_ordered.push_back(i);
+    d_order_hash ^= ZobristKeys::position(d_size, i);
+    d_ordered[d_size++] = i;
+}
+
+inline void CardStack::resolve_top(size_t n, tabletop_general::Rng &rng) {
+    if (not d_lazy)
+        return;
+    size_t bottom = n > d_size ? 0 : d_size - n;
+    for (size_t pos = d_size; pos-- != bottom; ) {
+        if (d_ordered[pos] != CardIdx::Unresolved)
+            continue;
+        uint8_t card = count_sample(d_unresolved.data(),
+            rng.below(count_total(d_unresolved.data())));
+        --d_unresolved[card];
+        d_ordered[pos] = from_uint(card);
+        d_order_hash ^= ZobristKeys::position(pos, from_uint(card));
+    }
+}
+
+inline void CardStack::resolve_top_as(CardIdx card) {
+    assert(d_size != 0 and d_ordered[d_size - 1] == CardIdx::Unresolved and
+           d_unresolved[to_uint(card)] != 0 && "Can't resolve to that card.");
+    --d_unresolved[to_uint(card)];
+    d_ordered[d_size - 1] = card;
+    d_order_hash ^= ZobristKeys::position(d_size - 1, card);
+}
+
+inline uint8_t const *CardStack::unresolved_counts() const {
+    return d_unresolved.data();
+}
+
+inline CardIdx CardStack::peek(size_t depth) const {
+    assert(depth < d_size && "Peeking below the bottom of the stack.");
+    return d_ordered[d_size - 1 - depth];
+}
+
+inline void CardStack::reveal(uint8_t player, size_t depth) {
+    if (d_size != 0)
+        d_known[player] |= 1ULL << (depth >= d_size ? 0 : d_size - 1 - depth);
+}
+
+inline uint64_t CardStack::known_mask(uint8_t player) const {
+    return d_known[player];
 }
 
 inline size_t CardStack::size() const {
-    return d_ordered.size();
+    return d_size;
+}
+
+inline uint64_t CardStack::order_hash() const {
+    return d_lazy ? d_order_hash ^ counts_hash() : d_order_hash;
 }
 
 } // namespace exploding_kittens
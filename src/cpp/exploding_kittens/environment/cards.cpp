@@ -6,7 +6,7 @@
 namespace exploding_kittens {
 
 
-void Cards::init_new_game(size_t num_players) {
+void Cards::init_new_game(size_t num_players, tabletop_general::Rng &rng) {
     if (num_players < MIN_PLAYERS or num_players > MAX_PLAYERS)
         throw std::invalid_argument("num_players out of legal range.");
     
@@ -20,15 +20,27 @@ void Cards::init_new_game(size_t num_players) {
         d_hands_internal.begin(), d_hands_internal.begin() + num_players};
     for (CardHand &hand : hands) {
         initArray<CardInfoField::init_hand>(num_players, hand.counts());
+        hand.rehash();
     }
 
     // Deal cards from discard pile to player hands:
-    discard_pile.ordered_from_data();
-    discard_pile.shuffle();
-    for (CardHand &hand : hands) {
-        for (size_t i = 0; i != CARDS_2_DEAL; ++i) {
-            CardIdx card = discard_pile.pop();
-            hand.base_insert(card);
+    if (deck.is_lazy()) {
+        // Draw them straight from the counts: nothing needs shuffling.
+        for (CardHand &hand : hands) {
+            for (size_t i = 0; i != CARDS_2_DEAL; ++i) {
+                CardIdx card = discard_pile.random_card(rng);
+                discard_pile.base_remove(card);
+                hand.base_insert(card);
+            }
+        }
+    } else {
+        discard_pile.ordered_from_data();
+        discard_pile.shuffle(rng);
+        for (CardHand &hand : hands) {
+            for (size_t i = 0; i != CARDS_2_DEAL; ++i) {
+                CardIdx card = discard_pile.pop();
+                hand.base_insert(card);
+            }
         }
     }
 
@@ -38,7 +50,7 @@ void Cards::init_new_game(size_t num_players) {
     std::fill(discard_pile.d_card_counts.begin(), discard_pile.d_card_counts.end(), 0);
     discard_pile.ordered_from_data();
     deck.ordered_from_data();
-    deck.shuffle();
+    deck.shuffle(rng);
 }
 
 } // namespace exploding_kittens
\ No newline at end of file
@@ -41,8 +41,9 @@ struct Cards {
      * @brief Reset own state to that of a new game.
      * 
      * @param num_players The number of players for the new game.
+     * @param rng The generator used for dealing and shuffling.
      */
-    void reset(size_t num_players);
+    void reset(size_t num_players, tabletop_general::Rng &rng);
     
     private:
         /**
@@ -50,21 +51,24 @@ struct Cards {
          * state.
          * 
          * @param num_players The number of players for the new game.
+         * @param rng The generator used for dealing and shuffling.
          * @todo I took the contents of this method out of the reset method
          * because I thought I wanted more from Cards. I don't anymore, so
          * might change it back later.
          * 
          * @throws std::invalid_argument if num_players too large or small.
          */
-        void init_new_game(size_t num_players);
+        void init_new_game(size_t num_players, tabletop_general::Rng &rng);
 
         // internally creating all hands. The hands object is just a subrange
         // of it.
         std::array<CardHand, MAX_PLAYERS> d_hands_internal;
+
+        friend struct GameState;    // For GameState::restore.
 };
 
-inline void Cards::reset(size_t num_players) {
-    init_new_game(num_players);
+inline void Cards::reset(size_t num_players, tabletop_general::Rng &rng) {
+    init_new_game(num_players, rng);
 }
 
 } // namespace exploding_kittens
@@ -0,0 +1,93 @@
+#ifndef EK_CHANCE_H
+#define EK_CHANCE_H
+
+#include "game_defs.h"
+#include "card_defs.h"
+#include "count_kernels.h"
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+
+
+namespace exploding_kittens {
+
+/**
+ * @brief The kinds of randomness an action can involve.
+ */
+enum class ChanceKind : uint8_t {
+    None,       // Deterministic: a single outcome.
+    Draw,       // Which card the top (unresolved) deck position turns out to
+                // be. The outcome value is a CardIdx.
+    Nope_Order  // In which order the players with a nope get to nope. The
+                // value is the rank of the permutation of those players (in
+                // increasing order of index, rank 0 is that order itself).
+};
+
+/**
+ * @brief One way a chance event can turn out.
+ */
+struct ChanceOutcome {
+    uint8_t value;          // Meaning depends on the ChanceKind.
+    double probability;
+};
+
+// Largest number of outcomes of any chance event: the orders of the nopers.
+constexpr size_t MAX_CHANCE_OUTCOMES = 120;     // MAX_PLAYERS!
+
+/**
+ * @brief All outcomes of the chance event of an action, with their
+ * probabilities (which sum to one). Fixed-capacity, so it can live on the
+ * stack. See Rules::chance_event.
+ */
+struct ChanceEvent {
+    ChanceKind kind = ChanceKind::None;
+    uint8_t size = 0;
+    std::array<ChanceOutcome, MAX_CHANCE_OUTCOMES> outcomes;
+
+    /**
+     * @brief Set to a deterministic event: one outcome, with probability 1.
+     */
+    void set_none();
+
+    /**
+     * @brief Set to the outcomes of a random card from a collection with the
+     * given counts (like CardCollection::random_card, or the draw of an
+     * unresolved position from CardStack::unresolved_counts): card i with
+     * probability counts[i] / total. The total should not be zero (asserted).
+     */
+    void set_cards(ChanceKind card_kind, uint8_t const *counts);
+
+    ChanceOutcome const *begin() const;
+    ChanceOutcome const *end() const;
+};
+
+inline void ChanceEvent::set_none() {
+    kind = ChanceKind::None;
+    size = 1;
+    outcomes[0] = ChanceOutcome{0, 1.0};
+}
+
+inline void ChanceEvent::set_cards(ChanceKind card_kind,
+                                   uint8_t const *counts) {
+    uint32_t total = count_total(counts);
+    assert(total != 0 && "No cards to choose from.");
+    kind = card_kind;
+    size = 0;
+    for (uint8_t i = 0; i != UNIQUE_CARDS; ++i)
+        if (counts[i] != 0)
+            outcomes[size++] = ChanceOutcome{i,
+                static_cast<double>(counts[i]) / total};
+}
+
+inline ChanceOutcome const *ChanceEvent::begin() const {
+    return outcomes.data();
+}
+
+inline ChanceOutcome const *ChanceEvent::end() const {
+    return outcomes.data() + size;
+}
+
+} // namespace exploding_kittens
+
+#endif // EK_CHANCE_H
\ No newline at end of file
@@ -0,0 +1,50 @@
+#include "count_kernels.h"
+
+#include <stdexcept>
+
+namespace exploding_kittens {
+
+void count_totals(std::span<uint8_t const> counts, std::span<uint8_t> out) {
+    if (counts.size() != out.size() * COUNTS_WIDTH)
+        throw std::invalid_argument("Need one output per count vector.");
+
+    size_t idx = 0;
+#if defined(__AVX2__)
+    // Two count vectors per register, four per iteration:
+    for (; idx + 4 <= out.size(); idx += 4) {
+        auto load = [&](size_t k) {
+            return _mm256_loadu_si256(reinterpret_cast<__m256i const *>(
+                counts.data() + (idx + k) * COUNTS_WIDTH));
+        };
+        __m256i a = load(0);
+        __m256i b = load(2);
+        __m256i zero = _mm256_setzero_si256();
+        // Per 64 bits a partial sum. Adding the pairs of halves:
+        __m256i sa = _mm256_sad_epu8(a, zero);
+        __m256i sb = _mm256_sad_epu8(b, zero);
+        __m256i sums = _mm256_add_epi64(sa, _mm256_srli_si256(sa, 8));
+        __m256i sums_b = _mm256_add_epi64(sb, _mm256_srli_si256(sb, 8));
+        out[idx] = _mm256_extract_epi8(sums, 0);
+        out[idx + 1] = _mm256_extract_epi8(sums, 16);
+        out[idx + 2] = _mm256_extract_epi8(sums_b, 0);
+        out[idx + 3] = _mm256_extract_epi8(sums_b, 16);
+    }
+#endif
+    for (; idx != out.size(); ++idx)
+        out[idx] = count_total(counts.data() + idx * COUNTS_WIDTH);
+}
+
+void count_samples(std::span<uint8_t const> counts,
+                   tabletop_general::Rng &rng, std::span<CardIdx> out) {
+    if (counts.size() != out.size() * COUNTS_WIDTH)
+        throw std::invalid_argument("Need one output per count vector.");
+
+    for (size_t idx = 0; idx != out.size(); ++idx) {
+        uint8_t const *row = counts.data() + idx * COUNTS_WIDTH;
+        uint32_t total = count_total(row);
+        out[idx] = total == 0 ? CardIdx::Error :
+            from_uint(count_sample(row, rng.below(total)));
+    }
+}
+
+} // namespace exploding_kittens
\ No newline at end of file
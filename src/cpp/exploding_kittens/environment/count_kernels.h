@@ -0,0 +1,122 @@
+// Vectorized kernels over card counts. A count vector is UNIQUE_CARDS bytes,
+// padded with zeros to COUNTS_WIDTH bytes, so it fits one SSE2 register.
+// Uses SSE2 (always there on x86-64), AVX2 for the batch kernels if compiled
+// with it (see the EK_ENABLE_AVX2 option), and a scalar fallback otherwise.
+
+#ifndef EK_COUNT_KERNELS_H
+#define EK_COUNT_KERNELS_H
+
+#include "card_defs.h"
+#include "../../utils.h"
+
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <span>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+
+namespace exploding_kittens {
+
+constexpr size_t COUNTS_WIDTH = 16;     // Padded size of a count vector.
+
+static_assert(UNIQUE_CARDS <= COUNTS_WIDTH, "Counts must fit in 16 bytes.");
+
+/**
+ * @return The sum of the counts (e.g. the number of cards in a hand).
+ */
+uint32_t count_total(uint8_t const *counts);
+
+/**
+ * @return A bitmask with bit i set if counts[i] != 0.
+ */
+uint16_t count_nonzero_mask(uint8_t const *counts);
+
+/**
+ * @brief Maps r to a card, each card owning as many consecutive values as its
+ * count. With r uniform in [0, count_total(counts)), this samples a card
+ * proportionally to the counts.
+ *
+ * @return The smallest i with counts[0] + ... + counts[i] > r.
+ * @note The total should be below 256 (which it always is: MAX_CARDS).
+ */
+uint8_t count_sample(uint8_t const *counts, uint32_t r);
+
+/**
+ * @brief Batch version of count_total over count vectors stored back to
+ * back: out[idx] is the total of counts[idx * COUNTS_WIDTH, ...].
+ * @throws std::invalid_argument unless counts holds out.size() vectors.
+ */
+void count_totals(std::span<uint8_t const> counts, std::span<uint8_t> out);
+
+/**
+ * @brief Batch sampling over count vectors stored back to back (as in
+ * count_totals): out[idx] is a random card from vector idx, or
+ * CardIdx::Error if that collection is empty. Draws one number from rng per
+ * non-empty collection, in order.
+ * @throws std::invalid_argument unless counts holds out.size() vectors.
+ */
+void count_samples(std::span<uint8_t const> counts,
+                   tabletop_general::Rng &rng, std::span<CardIdx> out);
+
+#if defined(__SSE2__)
+
+inline uint32_t count_total(uint8_t const *counts) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<__m128i const *>(counts));
+    __m128i sums = _mm_sad_epu8(x, _mm_setzero_si128());
+    return _mm_cvtsi128_si32(sums) + _mm_extract_epi16(sums, 4);
+}
+
+inline uint16_t count_nonzero_mask(uint8_t const *counts) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<__m128i const *>(counts));
+    int zeros = _mm_movemask_epi8(_mm_cmpeq_epi8(x, _mm_setzero_si128()));
+    return static_cast<uint16_t>(~zeros);
+}
+
+inline uint8_t count_sample(uint8_t const *counts, uint32_t r) {
+    assert(r < count_total(counts) && "Sampling index out of range.");
+    // Inclusive prefix sums in log steps:
+    __m128i x = _mm_loadu_si128(reinterpret_cast<__m128i const *>(counts));
+    x = _mm_add_epi8(x, _mm_slli_si128(x, 1));
+    x = _mm_add_epi8(x, _mm_slli_si128(x, 2));
+    x = _mm_add_epi8(x, _mm_slli_si128(x, 4));
+    x = _mm_add_epi8(x, _mm_slli_si128(x, 8));
+
+    // The sums are non-decreasing, so the answer is how many are <= r:
+    __m128i rv = _mm_set1_epi8(static_cast<char>(r));
+    int at_most_r = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(x, rv), rv));
+    return std::popcount(static_cast<uint32_t>(at_most_r));
+}
+
+#else   // Scalar fallback:
+
+inline uint32_t count_total(uint8_t const *counts) {
+    uint32_t total = 0;
+    for (size_t i = 0; i != COUNTS_WIDTH; ++i)
+        total += counts[i];
+    return total;
+}
+
+inline uint16_t count_nonzero_mask(uint8_t const *counts) {
+    uint16_t mask = 0;
+    for (size_t i = 0; i != COUNTS_WIDTH; ++i)
+        mask |= static_cast<uint16_t>(counts[i] != 0) << i;
+    return mask;
+}
+
+inline uint8_t count_sample(uint8_t const *counts, uint32_t r) {
+    assert(r < count_total(counts) && "Sampling index out of range.");
+    uint8_t i = 0;
+    while (r >= counts[i])
+        r -= counts[i++];
+    return i;
+}
+
+#endif
+
+} // namespace exploding_kittens
+
+#endif // EK_COUNT_KERNELS_H
\ No newline at end of file
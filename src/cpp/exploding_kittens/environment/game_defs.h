@@ -11,6 +11,9 @@ namespace exploding_kittens {
 constexpr size_t MIN_PLAYERS = 2;   // Minimum allowed number of players.
 constexpr size_t MAX_PLAYERS = 5;   // Maximum allowed number of players.
 constexpr size_t CARDS_2_DEAL = 7;  // Init cards per player. Excludes defuse.
+constexpr size_t MAX_CARDS = 56;    // Cards in a 5 player game: 4 kittens, 6
+                                    // defuses and 46 others. No stack or hand
+                                    // can ever hold more.
 
 /**
  * @brief Enum to describe discrete game states.
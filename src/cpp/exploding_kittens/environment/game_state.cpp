@@ -1,12 +1,19 @@
 #include "game_state.h"
 
+#include <algorithm>
+
 namespace exploding_kittens {
 
 void GameState::reset(size_t num_players) {
-    cards.reset(num_players);
+    cards.reset(num_players, rng);
     state = State::Default;
     primary_player = 0;     // Player 0 always starts.
     turns_left = 1;         // 1 turn p.p. by default. (Attack gives >1)
+
+    // No secondary info yet (cleared, so equal games have equal hashes):
+    secondary_players.clear();
+    is_noped = false;
+    staged_action = Action{};
 }
 
 uint8_t GameState::next_player(uint8_t player) const
@@ -17,6 +24,13 @@ uint8_t GameState::next_player(uint8_t player) const
     return player;
 }
 
+uint8_t GameState::winner() const {
+    for (uint8_t player = 0; player != num_players(); ++player)
+        if (is_alive(player))
+            return player;
+    return 0;
+}
+
 void GameState::register_turn() {
     if (--turns_left == 0) {
         turns_left = 1;
@@ -24,47 +38,103 @@ void GameState::register_turn() {
     }
 }
 
-// FNV-1a hash from:
-//   https://en.wikipedia.org/wiki/Fowler%E2%80%93Noll%E2%80%93Vo_hash_function
-uint32_t GameState::hash() {
-    constexpr uint32_t fnv_prime = 0x01000193u;
-    constexpr uint32_t fnv_offset = 0x811c9dc5u;
-    uint32_t hash = fnv_offset;
-
-    // Hashing the minimum card data to capture whole state:
-    for (CardIdx i : cards.deck.d_ordered) {
-        hash ^= to_uint(i);
-        hash *= fnv_prime;
-    }
-    for (CardIdx i : cards.discard_pile.d_ordered) {
-        hash ^= to_uint(i);
-        hash *= fnv_prime;
-    }
-    for (size_t player = 0; player != num_players(); ++player) {
-        uint8_t *counts = cards.hands[player].counts();
-        for (size_t i = 0; i != UNIQUE_CARDS; ++i) {
-            hash ^= counts[i];
-            hash *= fnv_prime;
-        }
-    }
+void GameState::save(GameStateSnapshot &snap) const {
+    auto save_stack = [](CardStack const &stack, auto &order, uint8_t &size,
+                         auto &counts) {
+        size = stack.d_size;
+        std::copy_n(stack.d_ordered.begin(), size, order.begin());
+        for (uint8_t i = 0; i != UNIQUE_CARDS; ++i)
+            counts[i] = stack.has(i);
+    };
+    save_stack(cards.deck, snap.deck, snap.deck_size, snap.deck_counts);
+    save_stack(cards.discard_pile, snap.discard_pile, snap.discard_size,
+        snap.discard_counts);
+    snap.deck_known = cards.deck.d_known;
+    snap.deck_lazy = cards.deck.d_lazy;
+
+    snap.num_players = num_players();
+    for (size_t player = 0; player != num_players(); ++player)
+        for (uint8_t i = 0; i != UNIQUE_CARDS; ++i)
+            snap.hands[player][i] = cards.hands[player].has(i);
+
+    snap.state = state;
+    snap.primary_player = primary_player;
+    snap.turns_left = turns_left;
+
+    snap.num_secondaries = secondary_players.size();
+    std::copy(secondary_players.begin(), secondary_players.end(),
+        snap.secondary_players.begin());
+    snap.is_noped = is_noped;
+    snap.staged_action = staged_action;
+
+    snap.rng = rng;
+}
 
-    // Hashing all the other stuff:
-    uint8_t nums[] = {
-        static_cast<uint8_t>(state), primary_player, turns_left,
-        static_cast<uint8_t>(is_noped),
-        static_cast<uint8_t>(staged_action.type),
-        staged_action.arg1, staged_action.arg2
+void GameState::restore(GameStateSnapshot const &snap) {
+    auto restore_stack = [](CardStack &stack, auto const &order, uint8_t size,
+                            auto const &counts) {
+        std::copy_n(order.begin(), size, stack.d_ordered.begin());
+        stack.d_size = size;
+        std::copy(counts.begin(), counts.end(), stack.counts());
     };
-    for (uint8_t i : nums) {
-        hash ^= i;
-        hash *= fnv_prime;
-    }
-    for (uint8_t i : secondary_players) {
-        hash ^= i;
-        hash *= fnv_prime;
-    }
+    restore_stack(cards.deck, snap.deck, snap.deck_size, snap.deck_counts);
+    restore_stack(cards.discard_pile, snap.discard_pile, snap.discard_size,
+        snap.discard_counts);
+    cards.deck.d_known = snap.deck_known;
+    cards.deck.d_lazy = snap.deck_lazy;
+
+    cards.hands = std::span<CardHand>{cards.d_hands_internal.begin(),
+        cards.d_hands_internal.begin() + snap.num_players};
+    for (size_t player = 0; player != snap.num_players; ++player)
+        std::copy(snap.hands[player].begin(), snap.hands[player].end(),
+            cards.hands[player].counts());
+
+    state = snap.state;
+    primary_player = snap.primary_player;
+    turns_left = snap.turns_left;
+
+    secondary_players.assign(snap.secondary_players.begin(),
+        snap.secondary_players.begin() + snap.num_secondaries);
+    is_noped = snap.is_noped;
+    staged_action = snap.staged_action;
+
+    rng = snap.rng;
+    rehash();
+}
+
+uint64_t GameState::full_hash() const {
+    uint64_t hash = cards.deck.compute_order_hash() ^
+                    std::rotl(cards.discard_pile.compute_order_hash(), 49);
+    for (size_t player = 0; player != num_players(); ++player)
+        hash ^= std::rotl(cards.hands[player].compute_counts_hash(),
+            7 * (player + 1));
+    return hash ^ scalars_hash();
+}
+
+void GameState::rehash() {
+    cards.deck.rehash();
+    cards.discard_pile.rehash();
+    for (CardHand &hand : cards.hands)
+        hand.rehash();
+}
+
+uint64_t GameState::scalars_hash() const {
+    uint64_t scalars =
+        static_cast<uint64_t>(state) |
+        static_cast<uint64_t>(primary_player) << 8 |
+        static_cast<uint64_t>(turns_left) << 16 |
+        static_cast<uint64_t>(is_noped) << 24 |
+        static_cast<uint64_t>(staged_action.type) << 32 |
+        static_cast<uint64_t>(staged_action.arg1) << 40 |
+        static_cast<uint64_t>(staged_action.arg2) << 48 |
+        static_cast<uint64_t>(num_players()) << 56;
+
+    uint64_t secondaries = secondary_players.size();
+    for (uint8_t player : secondary_players)
+        secondaries = secondaries << 8 | player;
 
-    return hash;
+    return tabletop_general::mix64(
+        tabletop_general::mix64(scalars) ^ secondaries);
 }
 
 } // namespace exploding_kittens
\ No newline at end of file
@@ -4,7 +4,12 @@
 #include "game_defs.h"
 #include "cards.h"
 #include "action_defs.h"
+#include "game_state_snapshot.h"
+#include "../../utils.h"
 
+#include <array>
+#include <bit>
+#include <cassert>
 #include <cstdint>
 #include <vector>
 
@@ -19,6 +24,9 @@ namespace exploding_kittens {
  */
 struct GameState {
     Cards cards;
+
+    // The source of all randomness in this game (deals, shuffles, etc.):
+    tabletop_general::Rng rng;
     
     // Primary state info (initialized at reset):
     State state;            // A discrete description of current state.
@@ -32,7 +40,11 @@ struct GameState {
                                             // definition the one at .back().
     bool is_noped;                          // If true, action is noped
     Action staged_action;                   // To execute if not noped
-    NopeableBase *action_type;              // Obj that can execute staged_action
+
+    // Not part of the state: for each ActionEnum, the NopeableBase bound to
+    // this game that can execute a staged action of that type. Filled in by
+    // the NopeableBase constructor.
+    std::array<NopeableBase *, UNIQUE_ACTIONS> nopeables{};
 
     /**
      * @brief Constructor for GameState object
@@ -48,12 +60,18 @@ struct GameState {
     GameState &operator=(GameState &&) = delete;
 
     /**
-     * @brief Reset own state to that of a new game.
+     * @brief Reset own state to that of a new game. Randomness is taken from
+     * this->rng, which is not re-seeded: consecutive resets give new games.
      * 
      * @param num_players The number of players for the new game.
      */
     void reset(size_t num_players);
 
+    /**
+     * @brief Shorthand for this->rng.seed(seed).
+     */
+    void seed(uint64_t seed);
+
     /**
      * @return the number of players in the current game.
      */
@@ -68,11 +86,25 @@ struct GameState {
      * @brief shorthand for this->cards.hands[this->primary_player]
      */
     CardHand &primary_hand();
+    CardHand const &primary_hand() const;
 
     /**
      * @brief shorthand for this->cards.hands[this->secondary_players.back()]
      */
     CardHand &secondary_hand();
+    CardHand const &secondary_hand() const;
+
+    /**
+     * @brief The player that has to choose the next action: the secondary
+     * player in the Nope and Favor states, the primary player otherwise.
+     */
+    uint8_t acting_player() const;
+
+    /**
+     * @return The first player that is still alive. Once the game is over,
+     * this is the player that won.
+     */
+    uint8_t winner() const;
     
     /**
      * @brief Convenience function: for a given player (index), returns who would
@@ -87,11 +119,57 @@ struct GameState {
     void register_turn();
 
     /**
-     * @return a hash for the current state.
+     * @brief Copy the complete state into a fixed-size snapshot.
+     */
+    void save(GameStateSnapshot &snap) const;
+
+    /**
+     * @brief Overwrite the complete state with that of a snapshot. Does not
+     * touch the nopeables registry (it is not part of the state).
+     */
+    void restore(GameStateSnapshot const &snap);
+
+    /**
+     * @return A 64-bit hash of the current state. The card collections
+     * maintain Zobrist hashes incrementally, so this only combines those with
+     * the few scalars: O(1). When compiled with EK_CHECK_HASH, asserts that
+     * the result equals full_hash().
+     */
+    uint64_t hash() const;
+
+    /**
+     * @return The same as hash(), but recomputed from scratch. For checking.
+     */
+    uint64_t full_hash() const;
+
+    /**
+     * @brief Recompute the incremental hashes of all card collections. Needed
+     * after writing card counts directly (see CardCollection::counts).
      */
-    uint32_t hash();
+    void rehash();
+
+    private:
+        // Hash of everything that is not in the card collections.
+        uint64_t scalars_hash() const;
 };
 
+inline uint64_t GameState::hash() const {
+    uint64_t hash = cards.deck.order_hash() ^
+                    std::rotl(cards.discard_pile.order_hash(), 49);
+    for (size_t player = 0; player != num_players(); ++player)
+        hash ^= std::rotl(cards.hands[player].counts_hash(), 7 * (player + 1));
+    hash ^= scalars_hash();
+
+#ifdef EK_CHECK_HASH
+    assert(hash == full_hash() && "Incremental hash out of sync.");
+#endif
+    return hash;
+}
+
+inline void GameState::seed(uint64_t seed) {
+    rng.seed(seed);
+}
+
 inline uint8_t GameState::num_players() const {
     return cards.hands.size();
 }
@@ -107,10 +185,24 @@ inline CardHand &GameState::primary_hand() {
     return cards.hands[primary_player];
 }
 
+inline CardHand const &GameState::primary_hand() const {
+    return cards.hands[primary_player];
+}
+
 inline CardHand &GameState::secondary_hand() {
     return cards.hands[secondary_players.back()];
 }
 
+inline CardHand const &GameState::secondary_hand() const {
+    return cards.hands[secondary_players.back()];
+}
+
+inline uint8_t GameState::acting_player() const {
+    if (state == State::Nope or state == State::Favor)
+        return secondary_players.back();
+    return primary_player;
+}
+
 } // namespace exploding_kittens
 
 #endif // #ifndef EK_GAME_STATE_H
\ No newline at end of file
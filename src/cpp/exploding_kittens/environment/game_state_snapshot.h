@@ -0,0 +1,58 @@
+#ifndef EK_GAME_STATE_SNAPSHOT_H
+#define EK_GAME_STATE_SNAPSHOT_H
+
+#include "game_defs.h"
+#include "card_defs.h"
+#include "action_defs.h"
+#include "../../utils.h"
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+
+namespace exploding_kittens {
+
+/**
+ * @brief A fixed-size copy of everything in a GameState, for when a state has
+ * to be cloned many times (e.g. tree search). It contains no pointers and no
+ * heap memory, so copying one is a plain memcpy of a few hundred bytes.
+ * See GameState::save and GameState::restore.
+ */
+struct GameStateSnapshot {
+    // Card stacks, ordered from bottom to top (only first *_size are valid):
+    std::array<CardIdx, MAX_CARDS> deck;
+    std::array<CardIdx, MAX_CARDS> discard_pile;
+    uint8_t deck_size;
+    uint8_t discard_size;
+    bool deck_lazy;         // If so, deck can hold CardIdx::Unresolved.
+
+    // Per player, which deck cards they know (see CardStack::known_mask):
+    std::array<uint64_t, MAX_PLAYERS> deck_known;
+
+    // Counts of the stacks and all hands (only first num_players are valid):
+    std::array<uint8_t, UNIQUE_CARDS> deck_counts;
+    std::array<uint8_t, UNIQUE_CARDS> discard_counts;
+    std::array<std::array<uint8_t, UNIQUE_CARDS>, MAX_PLAYERS> hands;
+    uint8_t num_players;
+
+    // Primary state info:
+    State state;
+    uint8_t primary_player;
+    uint8_t turns_left;
+
+    // Secondary info (next secondary at secondary_players[num_secondaries-1]):
+    std::array<uint8_t, MAX_PLAYERS> secondary_players;
+    uint8_t num_secondaries;
+    bool is_noped;
+    Action staged_action;   // Its type also selects the NopeableBase to run.
+
+    tabletop_general::Rng rng;
+};
+
+static_assert(std::is_trivially_copyable_v<GameStateSnapshot>,
+    "GameStateSnapshot must be copyable with a memcpy.");
+
+} // namespace exploding_kittens
+
+#endif // EK_GAME_STATE_SNAPSHOT_H
\ No newline at end of file
@@ -0,0 +1,58 @@
+#include "observation.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace exploding_kittens {
+
+template <typename T>
+void encode_observation(GameState const &gs, uint8_t viewer,
+                        std::span<T> out) {
+    if (out.size() != OBS_SIZE)
+        throw std::invalid_argument("Observation must have length OBS_SIZE.");
+    uint8_t num_players = gs.num_players();
+    if (viewer >= num_players)
+        throw std::invalid_argument("Viewer is not a player of this game.");
+
+    std::fill(out.begin(), out.end(), T{});
+    auto relative = [&](uint8_t player) {
+        return (player + num_players - viewer) % num_players;
+    };
+
+    uint8_t const *own = gs.cards.hands[viewer].counts();
+    uint8_t const *discard = gs.cards.discard_pile.counts();
+    for (size_t i = 0; i != UNIQUE_CARDS; ++i) {
+        out[OBS_OWN_HAND + i] = own[i];
+        out[OBS_DISCARD + i] = discard[i];
+    }
+
+    for (uint8_t player = 0; player != num_players; ++player) {
+        size_t rel = relative(player);
+        out[OBS_HAND_SIZES + rel] = gs.cards.hands[player].total();
+        out[OBS_ALIVE + rel] = gs.is_alive(player);
+    }
+
+    CardStack const &deck = gs.cards.deck;
+    out[OBS_DECK_SIZE] = deck.size();
+    uint64_t known = deck.known_mask(viewer);
+    size_t depths = std::min(OBS_KNOWN_DEPTH, deck.size());
+    for (size_t depth = 0; depth != depths; ++depth)
+        if (known >> (deck.size() - 1 - depth) & 1)
+            out[OBS_KNOWN_TOP + depth * UNIQUE_CARDS +
+                to_uint(deck.peek(depth))] = 1;
+
+    out[OBS_STATE + static_cast<size_t>(gs.state)] = 1;
+    out[OBS_TURNS_LEFT] = gs.turns_left;
+    out[OBS_PRIMARY + relative(gs.primary_player)] = 1;
+    if (gs.state == State::Nope) {
+        out[OBS_STAGED + static_cast<size_t>(gs.staged_action.type)] = 1;
+        out[OBS_NOPED] = gs.is_noped;
+    }
+}
+
+template void encode_observation<float>(GameState const &, uint8_t,
+                                        std::span<float>);
+template void encode_observation<uint8_t>(GameState const &, uint8_t,
+                                          std::span<uint8_t>);
+
+} // namespace exploding_kittens
\ No newline at end of file
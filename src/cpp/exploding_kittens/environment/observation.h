@@ -0,0 +1,74 @@
+#ifndef EK_OBSERVATION_H
+#define EK_OBSERVATION_H
+
+#include "game_state.h"
+#include "game_defs.h"
+#include "card_defs.h"
+#include "action_defs.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+
+namespace exploding_kittens {
+
+/**
+ * @brief The layout of an observation: what one player can see of a game, as
+ * a fixed-size vector of numbers. Players are numbered relative to the viewer
+ * (0 is the viewer, 1 the next player, etc.), so the same policy works from
+ * every seat. Sections (offset: length):
+ *
+ * - OBS_OWN_HAND: UNIQUE_CARDS             Counts of the viewer's hand.
+ * - OBS_HAND_SIZES: MAX_PLAYERS            Number of cards per player.
+ * - OBS_ALIVE: MAX_PLAYERS                 1 per player still in the game.
+ * - OBS_DECK_SIZE: 1                       Number of cards in the deck.
+ * - OBS_KNOWN_TOP: OBS_KNOWN_DEPTH * UNIQUE_CARDS
+ *                                          Per depth from the top, a one-hot
+ *                                          of the card there if the viewer
+ *                                          knows it, else zeros.
+ * - OBS_DISCARD: UNIQUE_CARDS              Counts of the discard pile.
+ * - OBS_STATE: NUM_STATES                  One-hot of the State.
+ * - OBS_TURNS_LEFT: 1                      Turns left for the primary player.
+ * - OBS_PRIMARY: MAX_PLAYERS               One-hot of the primary player.
+ * - OBS_STAGED: UNIQUE_ACTIONS             One-hot of the staged action type
+ *                                          (all zeros outside the Nope state).
+ * - OBS_NOPED: 1                           1 if the staged action is noped.
+ *
+ * Entries of absent players are zero. All values are small counts or flags,
+ * so the layout can be written as floats or as bytes.
+ */
+constexpr size_t NUM_STATES = static_cast<size_t>(State::Game_Over) + 1;
+constexpr size_t OBS_KNOWN_DEPTH = 8;   // Known deck cards: only the top ones.
+
+constexpr size_t OBS_OWN_HAND = 0;
+constexpr size_t OBS_HAND_SIZES = OBS_OWN_HAND + UNIQUE_CARDS;
+constexpr size_t OBS_ALIVE = OBS_HAND_SIZES + MAX_PLAYERS;
+constexpr size_t OBS_DECK_SIZE = OBS_ALIVE + MAX_PLAYERS;
+constexpr size_t OBS_KNOWN_TOP = OBS_DECK_SIZE + 1;
+constexpr size_t OBS_DISCARD = OBS_KNOWN_TOP + OBS_KNOWN_DEPTH * UNIQUE_CARDS;
+constexpr size_t OBS_STATE = OBS_DISCARD + UNIQUE_CARDS;
+constexpr size_t OBS_TURNS_LEFT = OBS_STATE + NUM_STATES;
+constexpr size_t OBS_PRIMARY = OBS_TURNS_LEFT + 1;
+constexpr size_t OBS_STAGED = OBS_PRIMARY + MAX_PLAYERS;
+constexpr size_t OBS_NOPED = OBS_STAGED + UNIQUE_ACTIONS;
+constexpr size_t OBS_SIZE = OBS_NOPED + 1;   // Length of an observation.
+
+/**
+ * @brief Writes what viewer can see of gs into out, following the layout
+ * above. Hidden information (other hands, the deck order apart from the
+ * cards the viewer knows, see CardStack::known_mask) is left out. Does not
+ * allocate.
+ *
+ * @tparam T float or uint8_t.
+ * @param out Output. Must have length OBS_SIZE.
+ * @throws std::invalid_argument if out has the wrong length, or viewer is not
+ * a player of the game.
+ */
+template <typename T>
+void encode_observation(GameState const &gs, uint8_t viewer,
+                        std::span<T> out);
+
+} // namespace exploding_kittens
+
+#endif // EK_OBSERVATION_H
\ No newline at end of file
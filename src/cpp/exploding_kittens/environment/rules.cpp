@@ -0,0 +1,224 @@
+#include "rules.h"
+#include "actions/draw_card.h"
+#include "actions/nope_utils.h"
+#include "actions/play_defuse.h"
+#include "actions/play_nope.h"
+#include "actions/skip_nope.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace exploding_kittens {
+
+void Rules::append_legal_actions(GameState const &g, ActionList &list) {
+    switch (g.state) {
+        case State::Default:
+            DrawCard::legal_actions(g, list);
+            break;
+        case State::Defuse:
+            PlayDefuse::legal_actions(g, list);
+            break;
+        case State::Nope:
+            PlayNope::legal_actions(g, list);
+            SkipNope::legal_actions(g, list);
+            break;
+        default:    // Favor not implemented yet, Game_Over has no actions.
+            break;
+    }
+}
+
+void Rules::take_action(GameState &g, Action const &a) {
+    switch (a.type) {
+        case ActionEnum::Draw:
+            DrawCard::apply(g, a);
+            break;
+        case ActionEnum::Play_Defuse:
+            PlayDefuse::apply(g, a);
+            break;
+        case ActionEnum::Play_Nope:
+            PlayNope::apply(g, a);
+            break;
+        case ActionEnum::Skip_Nope:
+            SkipNope::apply(g, a);
+            break;
+        default:
+            throw std::invalid_argument("Action type not implemented.");
+    }
+}
+
+// The players that can nope after the acting secondary plays a nope, in
+// increasing order. Returns how many there are.
+static uint8_t nopers_after_nope(GameState const &g,
+                                 std::array<uint8_t, MAX_PLAYERS> &out) {
+    uint8_t count = 0;
+    for (uint8_t player = 0; player != g.num_players(); ++player) {
+        uint8_t nopes = g.cards.hands[player].has(CardIdx::Nope) -
+                        (player == g.secondary_players.back());
+        if (g.is_alive(player) and nopes != 0)
+            out[count++] = player;
+    }
+    return count;
+}
+
+// Whether a ends the Nope state with the staged action carried out:
+static bool enforces_staged(GameState const &g, Action const &a) {
+    if (a.type == ActionEnum::Skip_Nope)
+        return g.secondary_players.size() == 1 and not g.is_noped;
+    if (a.type != ActionEnum::Play_Nope or not g.is_noped)
+        return false;
+
+    // The nope un-nopes the action. Enforced unless anyone can nope again:
+    std::array<uint8_t, MAX_PLAYERS> nopers;
+    return nopers_after_nope(g, nopers) == 0;
+}
+
+// Whether drawing in g reveals an unresolved position:
+static bool draws_unresolved(GameState const &g, Action const &a) {
+    return a.type == ActionEnum::Draw and g.cards.deck.size() != 0 and
+           g.cards.deck.peek(0) == CardIdx::Unresolved;
+}
+
+// Puts the secondary players in the order with the given rank: the
+// permutation of them in increasing order with that index in the
+// lexicographic order of permutations.
+static void order_secondaries(GameState &g, size_t rank) {
+    std::vector<uint8_t> &players = g.secondary_players;
+    std::sort(players.begin(), players.end());
+    size_t factorial = 1;
+    for (size_t n = 2; n < players.size(); ++n)
+        factorial *= n;
+    for (size_t idx = 0; idx + 1 < players.size(); ++idx) {
+        size_t pick = idx + rank / factorial;
+        rank %= factorial;
+        std::rotate(players.begin() + idx, players.begin() + pick,
+                    players.begin() + pick + 1);
+        factorial /= players.size() - 1 - idx;
+    }
+}
+
+UndoRecord Rules::make_action(GameState &g, Action const &a) {
+    if (enforces_staged(g, a))
+        throw std::invalid_argument("Can not record carrying out a staged "
+                                    "action.");
+
+    UndoRecord undo;
+    undo.state = g.state;
+    undo.primary_player = g.primary_player;
+    undo.turns_left = g.turns_left;
+    undo.num_secondaries = g.secondary_players.size();
+    std::copy(g.secondary_players.begin(), g.secondary_players.end(),
+        undo.secondary_players.begin());
+    undo.is_noped = g.is_noped;
+    undo.staged_action = g.staged_action;
+    undo.rng = g.rng;
+
+    switch (a.type) {
+        case ActionEnum::Draw:
+            DrawCard::record(g, a, undo);
+            break;
+        case ActionEnum::Play_Defuse:
+            PlayDefuse::record(g, a, undo);
+            break;
+        case ActionEnum::Play_Nope:
+            PlayNope::record(g, a, undo);
+            break;
+        case ActionEnum::Skip_Nope:     // Moves no cards.
+            break;
+        default:
+            throw std::invalid_argument("Action type not implemented.");
+    }
+    take_action(g, a);
+    return undo;
+}
+
+void Rules::undo_action(GameState &g, UndoRecord const &undo) {
+    auto stack = [&](uint8_t place) -> CardStack & {
+        return place == PLACE_DECK ? g.cards.deck : g.cards.discard_pile;
+    };
+
+    // Moving the cards back, last move first:
+    for (size_t idx = undo.num_moves; idx-- != 0; ) {
+        CardMove const &move = undo.moves[idx];
+        if (move.to < MAX_PLAYERS and move.from < MAX_PLAYERS) {
+            g.cards.hands[move.to].give_to(g.cards.hands[move.from],
+                                           move.card);
+        } else if (move.to < MAX_PLAYERS) {
+            CardStack &from = stack(move.from);
+            g.cards.hands[move.to].place_at(from, move.card, move.depth);
+            for (uint8_t player = 0; player != g.num_players(); ++player)
+                if (move.known_by >> player & 1)
+                    from.reveal(player, move.depth);
+            if (move.unresolved)
+                from.unresolve_top();
+        } else {
+            g.cards.hands[move.from].take_from(stack(move.to), move.depth);
+        }
+    }
+
+    g.state = undo.state;
+    g.primary_player = undo.primary_player;
+    g.turns_left = undo.turns_left;
+    g.secondary_players.assign(undo.secondary_players.begin(),
+        undo.secondary_players.begin() + undo.num_secondaries);
+    g.is_noped = undo.is_noped;
+    g.staged_action = undo.staged_action;
+    g.rng = undo.rng;
+}
+
+void Rules::chance_event(GameState const &g, Action const &a,
+                         ChanceEvent &out) {
+    if (draws_unresolved(g, a)) {
+        out.set_cards(ChanceKind::Draw, g.cards.deck.unresolved_counts());
+        return;
+    }
+
+    std::array<uint8_t, MAX_PLAYERS> nopers;
+    uint8_t count = a.type == ActionEnum::Play_Nope ?
+        nopers_after_nope(g, nopers) : 0;
+    if (count < 2) {
+        out.set_none();
+        return;
+    }
+    size_t orders = 1;
+    for (size_t n = 2; n <= count; ++n)
+        orders *= n;
+    out.kind = ChanceKind::Nope_Order;
+    out.size = orders;
+    for (size_t rank = 0; rank != orders; ++rank)
+        out.outcomes[rank] = ChanceOutcome{static_cast<uint8_t>(rank),
+                                           1.0 / orders};
+}
+
+void Rules::take_action(GameState &g, Action const &a,
+                        ChanceOutcome const &outcome) {
+    if (draws_unresolved(g, a))
+        g.cards.deck.resolve_top_as(from_uint(outcome.value));
+    take_action(g, a);
+    if (a.type == ActionEnum::Play_Nope and g.secondary_players.size() > 1)
+        order_secondaries(g, outcome.value);
+}
+
+UndoRecord Rules::make_action(GameState &g, Action const &a,
+                              ChanceOutcome const &outcome) {
+    bool forced_draw = draws_unresolved(g, a);
+    if (forced_draw)
+        g.cards.deck.resolve_top_as(from_uint(outcome.value));
+    UndoRecord undo = make_action(g, a);
+    if (forced_draw)    // Resolved above, so the undo has to unresolve it:
+        undo.moves[0].unresolved = true;
+    if (a.type == ActionEnum::Play_Nope and g.secondary_players.size() > 1)
+        order_secondaries(g, outcome.value);
+    return undo;
+}
+
+void Rules::enforce_action(GameState &g, Action const &a) {
+    // None of the nopeable actions have static rules yet. Once they do, they
+    // get a switch here like in take_action. Until then, only the objects in
+    // the registry can be enforced:
+    NopeableBase *action_type = g.nopeables[static_cast<size_t>(a.type)];
+    if (action_type == nullptr)
+        throw std::invalid_argument("Nopeable type not implemented.");
+    action_type->enforce_action(a);
+}
+
+} // namespace exploding_kittens
\ No newline at end of file
@@ -0,0 +1,95 @@
+#ifndef EK_RULES_H
+#define EK_RULES_H
+
+#include "action_defs.h"
+#include "action_list.h"
+#include "chance.h"
+#include "game_state.h"
+#include "undo_record.h"
+
+
+namespace exploding_kittens {
+
+/**
+ * @brief The rules of the game as plain functions over a GameState. Dispatches
+ * on State and ActionEnum with switch statements (jump tables) into the static
+ * rule functions of the ActionType classes, so no virtual calls or per-game
+ * objects are needed: one Rules serves any number of games.
+ *
+ * The ActionType objects remain usable for a single bound game. Nopeable
+ * actions that Rules does not know of (i.e. that only exist as a NopeableBase
+ * object) are still enforced through the gs.nopeables registry.
+ */
+struct Rules {
+
+    /**
+     * @brief Appends all actions that are legal in g. Only the action types
+     * that can be legal in the current State get queried.
+     */
+    static void append_legal_actions(GameState const &g, ActionList &list);
+
+    /**
+     * @brief Executes a on g.
+     * @throws std::invalid_argument if the action type is not implemented.
+     */
+    static void take_action(GameState &g, Action const &a);
+
+    /**
+     * @brief Executes a on g like take_action, but also returns what is
+     * needed to take it back with undo_action. That way a depth-first search
+     * can walk the game tree on a single state, without copying it.
+     * @throws std::invalid_argument if the action type is not implemented,
+     * or if a would carry out a staged action of the nopeables registry
+     * (which can do anything, so it can not be recorded). Nothing changes
+     * when it throws.
+     */
+    static UndoRecord make_action(GameState &g, Action const &a);
+
+    /**
+     * @brief Takes back the last action made on g: restores g exactly
+     * (hashes, known cards, unresolved deck positions and the position of
+     * g.rng included) to before make_action returned undo. Undo records have
+     * to be undone last one first.
+     */
+    static void undo_action(GameState &g, UndoRecord const &undo);
+
+    /**
+     * @brief The chance event that taking a in g involves, with all its
+     * outcomes: a Draw from an unresolved deck position (see
+     * CardStack::set_lazy and CardStack::forget_unknown), or the order of the
+     * nopers after a Play_Nope. Otherwise a single outcome (ChanceKind::None).
+     *
+     * Cards at resolved positions (e.g. the whole deck, if it is not lazy)
+     * are fixed, so drawing them is no chance event. Neither is a shuffle of
+     * a lazy deck: it only forgets the order.
+     */
+    static void chance_event(GameState const &g, Action const &a,
+                             ChanceEvent &out);
+
+    /**
+     * @brief Executes a on g, with its chance event turning out as outcome
+     * (one of the outcomes given by chance_event for g and a).
+     * @throws std::invalid_argument if the action type is not implemented.
+     */
+    static void take_action(GameState &g, Action const &a,
+                            ChanceOutcome const &outcome);
+
+    /**
+     * @brief Like take_action with an outcome, but returns an UndoRecord
+     * like make_action.
+     * @throws std::invalid_argument like make_action.
+     */
+    static UndoRecord make_action(GameState &g, Action const &a,
+                                  ChanceOutcome const &outcome);
+
+    /**
+     * @brief Carries out a nopeable action that survived the Nope state.
+     * @throws std::invalid_argument if the type has no implementation (and no
+     * object in g.nopeables).
+     */
+    static void enforce_action(GameState &g, Action const &a);
+};
+
+} // namespace exploding_kittens
+
+#endif // EK_RULES_H
\ No newline at end of file
@@ -0,0 +1,68 @@
+#ifndef EK_UNDO_RECORD_H
+#define EK_UNDO_RECORD_H
+
+#include "game_defs.h"
+#include "card_defs.h"
+#include "action_defs.h"
+#include "../../utils.h"
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+
+
+namespace exploding_kittens {
+
+// Places a card can move between. The hands are the players themselves:
+constexpr uint8_t PLACE_DECK = MAX_PLAYERS;
+constexpr uint8_t PLACE_DISCARD_PILE = MAX_PLAYERS + 1;
+
+/**
+ * @brief One card moving from one place (a player's hand, or a stack) to
+ * another.
+ */
+struct CardMove {
+    CardIdx card;
+    uint8_t from;       // A player, PLACE_DECK or PLACE_DISCARD_PILE.
+    uint8_t to;
+    uint8_t depth;      // Position in the stack it left or entered (0 = top).
+    uint8_t known_by;   // Left a stack: bit p set if player p knew the card.
+    bool unresolved;    // Left an unresolved position of a lazy stack.
+};
+
+constexpr size_t MAX_MOVES = 8;     // Card moves a single action can make.
+
+/**
+ * @brief Everything needed to take back one action: the scalars of the
+ * GameState before it (including the position of its random number
+ * generator), and the cards it moved, in order. Returned by
+ * Rules::make_action and consumed by Rules::undo_action. It has a fixed size
+ * and no heap memory, so a depth-first search can keep one per ply.
+ */
+struct UndoRecord {
+    State state;
+    uint8_t primary_player;
+    uint8_t turns_left;
+    uint8_t num_secondaries;
+    std::array<uint8_t, MAX_PLAYERS> secondary_players;
+    bool is_noped;
+    Action staged_action;
+    tabletop_general::Rng rng;
+
+    uint8_t num_moves = 0;
+    std::array<CardMove, MAX_MOVES> moves;
+
+    /**
+     * @brief Append a move. There should be room for it (asserted).
+     */
+    void add_move(CardMove const &move);
+};
+
+inline void UndoRecord::add_move(CardMove const &move) {
+    assert(num_moves != MAX_MOVES && "Too many card moves in one action.");
+    moves[num_moves++] = move;
+}
+
+} // namespace exploding_kittens
+
+#endif // EK_UNDO_RECORD_H
\ No newline at end of file
@@ -0,0 +1,127 @@
+#include "vector_game_state.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace exploding_kittens {
+
+namespace {
+
+template <typename T>
+void encode_rows(VectorGameState const &games,
+                 std::span<uint8_t const> viewers, std::span<T> out) {
+    if (out.size() != games.size() * OBS_SIZE)
+        throw std::invalid_argument("Need one observation row per game.");
+    for (size_t idx = 0; idx != games.size(); ++idx)
+        encode_observation(games[idx], viewers[idx],
+            out.subspan(idx * OBS_SIZE, OBS_SIZE));
+}
+
+} // namespace
+
+VectorGameState::VectorGameState(size_t num_games, size_t num_players,
+                                 uint64_t seed, bool lazy_deck)
+:
+    d_num_players(num_players),
+    d_games(new GameState[num_games]),
+    d_states(num_games),
+    d_acting_players(num_games),
+    d_turns_left(num_games),
+    d_counts(num_games * (num_players + 2) * COUNTS_WIDTH)
+{
+    tabletop_general::Rng base(seed);
+    for (size_t idx = 0; idx != num_games; ++idx) {
+        d_games[idx].rng = base.split(idx);
+        d_games[idx].cards.deck.set_lazy(lazy_deck);
+    }
+    reset();
+}
+
+void VectorGameState::reset() {
+    for (size_t idx = 0; idx != size(); ++idx)
+        reset(idx);
+}
+
+void VectorGameState::reset(size_t idx) {
+    d_games[idx].reset(d_num_players);
+    sync(idx);
+}
+
+void VectorGameState::step(std::span<Action const> actions) {
+    if (actions.size() != size())
+        throw std::invalid_argument("Need exactly one action per game.");
+    for (size_t idx = 0; idx != size(); ++idx)
+        step(idx, actions[idx]);
+}
+
+void VectorGameState::step(std::span<ActionCode const> codes) {
+    if (codes.size() != size())
+        throw std::invalid_argument("Need exactly one action per game.");
+    for (size_t idx = 0; idx != size(); ++idx)
+        step(idx, decode_action(codes[idx]));
+}
+
+void VectorGameState::step(size_t idx, Action const &a) {
+    if (d_states[idx] == State::Game_Over)
+        return;
+    Rules::take_action(d_games[idx], a);
+    sync(idx);
+}
+
+void VectorGameState::append_legal_actions(size_t idx,
+                                            ActionList &list) const {
+    Rules::append_legal_actions(d_games[idx], list);
+}
+
+void VectorGameState::legal_action_masks(std::span<uint8_t> masks) const {
+    if (masks.size() != size() * NUM_ACTION_CODES)
+        throw std::invalid_argument("Need one mask row per game.");
+    ActionList legal;
+    for (size_t idx = 0; idx != size(); ++idx) {
+        legal.clear();
+        append_legal_actions(idx, legal);
+        legal_action_mask(legal,
+            masks.subspan(idx * NUM_ACTION_CODES, NUM_ACTION_CODES));
+    }
+}
+
+void VectorGameState::observations(std::span<float> out) const {
+    encode_rows(*this, acting_players(), out);
+}
+
+void VectorGameState::observations(std::span<uint8_t> out) const {
+    encode_rows(*this, acting_players(), out);
+}
+
+void VectorGameState::hand_sizes(std::span<uint8_t> out) const {
+    count_totals(hand_counts(), out);
+}
+
+void VectorGameState::sample_hand_cards(tabletop_general::Rng &rng,
+                                        std::span<CardIdx> out) const {
+    count_samples(hand_counts(), rng, out);
+}
+
+bool VectorGameState::all_done() const {
+    return std::all_of(d_states.begin(), d_states.end(),
+        [](State s) { return s == State::Game_Over; });
+}
+
+void VectorGameState::sync(size_t idx) {
+    GameState const &g = d_games[idx];
+    d_states[idx] = g.state;
+    d_acting_players[idx] = g.acting_player();
+    d_turns_left[idx] = g.turns_left;
+
+    auto mirror = [&](CardCollection const &c, size_t row) {
+        std::copy_n(c.counts(), COUNTS_WIDTH,
+            d_counts.begin() + row * COUNTS_WIDTH);
+    };
+    size_t hands = size() * d_num_players;
+    for (size_t p = 0; p != d_num_players; ++p)
+        mirror(g.cards.hands[p], idx * d_num_players + p);
+    mirror(g.cards.deck, hands + idx);
+    mirror(g.cards.discard_pile, hands + size() + idx);
+}
+
+} // namespace exploding_kittens
\ No newline at end of file
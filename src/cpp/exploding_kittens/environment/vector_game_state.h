@@ -0,0 +1,209 @@
+#ifndef EK_VECTOR_GAME_STATE_H
+#define EK_VECTOR_GAME_STATE_H
+
+#include "game_state.h"
+#include "action_codec.h"
+#include "observation.h"
+#include "rules.h"
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+
+namespace exploding_kittens {
+
+/**
+ * @brief A batch of games that get stepped together. The GameState objects
+ * live in a single contiguous allocation. What a driver or batch kernel needs
+ * every step is mirrored out of the games into flat arrays: the scalars
+ * (State, acting player, turns_left), and the card counts of all
+ * collections in one buffer. Those can then be scanned without touching the
+ * games. The games stay the authority: the mirrors are refreshed by sync,
+ * which step and reset call.
+ */
+class VectorGameState {
+
+    size_t d_num_players;
+
+    std::unique_ptr<GameState[]> d_games;   // N games, contiguous.
+
+    // Mirrors of the per-game scalars:
+    std::vector<State> d_states;
+    std::vector<uint8_t> d_acting_players;
+    std::vector<uint8_t> d_turns_left;
+
+    // Mirror of the card counts, COUNTS_WIDTH bytes per collection. Three
+    // game-major blocks: all hands, all decks, all discard piles.
+    std::vector<uint8_t> d_counts;
+
+    public:
+        /**
+         * @brief Creates num_games games, all reset to a new game. Game idx
+         * gets its own random stream: Rng(seed).split(idx).
+         *
+         * @param num_games The number of games in the batch.
+         * @param num_players The number of players in each game.
+         * @param seed Seed from which the per-game generators are derived.
+         * @param lazy_deck Whether the decks are shuffled lazily (see
+         * CardStack::set_lazy).
+         * @throws std::invalid_argument if num_players too large or small.
+         */
+        VectorGameState(size_t num_games, size_t num_players,
+                        uint64_t seed = 0, bool lazy_deck = false);
+
+        /**
+         * @return The number of games in the batch.
+         */
+        size_t size() const;
+
+        /**
+         * @brief Reset all games to a new game.
+         */
+        void reset();
+
+        /**
+         * @brief Reset only game idx to a new game.
+         */
+        void reset(size_t idx);
+
+        /**
+         * @brief Advance every game by one action. Games that are in the
+         * Game_Over state ignore their action.
+         *
+         * @param actions One action per game. Must have length size().
+         * @throws std::invalid_argument if actions has the wrong length.
+         */
+        void step(std::span<Action const> actions);
+
+        /**
+         * @brief Like step above, but with actions from the flat action space.
+         *
+         * @param codes One action code per game. Must have length size().
+         * @throws std::invalid_argument if codes has the wrong length.
+         */
+        void step(std::span<ActionCode const> codes);
+
+        /**
+         * @brief Advance only game idx by one action.
+         */
+        void step(size_t idx, Action const &a);
+
+        /**
+         * @brief Appends the actions that are legal in game idx.
+         */
+        void append_legal_actions(size_t idx, ActionList &list) const;
+
+        /**
+         * @brief Writes the legality masks of all games over the flat action
+         * space: row idx (of NUM_ACTION_CODES entries) is the mask of game
+         * idx. Rows of finished games are all zeros.
+         *
+         * @param masks Output. Must have length size() * NUM_ACTION_CODES.
+         * @throws std::invalid_argument if masks has the wrong length.
+         */
+        void legal_action_masks(std::span<uint8_t> masks) const;
+
+        /**
+         * @brief Writes the observation of every game for its acting player
+         * (see encode_observation): row idx (of OBS_SIZE entries) is that of
+         * game idx. Does not allocate.
+         *
+         * @param out Output. Must have length size() * OBS_SIZE.
+         * @throws std::invalid_argument if out has the wrong length.
+         */
+        void observations(std::span<float> out) const;
+        void observations(std::span<uint8_t> out) const;
+
+        /**
+         * @brief The number of cards in every hand, with the vectorized batch
+         * kernel. out[idx * num_players + p] is player p's in game idx.
+         *
+         * @param out Output. Must have length size() * num_players.
+         * @throws std::invalid_argument if out has the wrong length.
+         */
+        void hand_sizes(std::span<uint8_t> out) const;
+
+        /**
+         * @brief Draws a random card from every hand (without removing it),
+         * laid out like hand_sizes. Empty hands give CardIdx::Error.
+         *
+         * @param rng The generator to draw from.
+         * @param out Output. Must have length size() * num_players.
+         * @throws std::invalid_argument if out has the wrong length.
+         */
+        void sample_hand_cards(tabletop_general::Rng &rng,
+                               std::span<CardIdx> out) const;
+
+        /**
+         * @return true if every game in the batch is in the Game_Over state.
+         */
+        bool all_done() const;
+
+        /**
+         * @brief Direct access to game idx. Call sync(idx) after altering it
+         * by other means than step.
+         */
+        GameState &operator[](size_t idx);
+        GameState const &operator[](size_t idx) const;
+
+        /**
+         * @brief Refresh the flat arrays for game idx from the GameState.
+         */
+        void sync(size_t idx);
+
+        // Flat views of the mirrored per-game scalars:
+        std::span<State const> states() const;
+        std::span<uint8_t const> acting_players() const;
+        std::span<uint8_t const> turns_left() const;
+
+        // Flat views of the mirrored counts, COUNTS_WIDTH bytes per
+        // collection (see count_kernels.h). Hand p of game idx is row
+        // idx * num_players + p, the stacks of game idx are row idx.
+        std::span<uint8_t const> hand_counts() const;
+        std::span<uint8_t const> deck_counts() const;
+        std::span<uint8_t const> discard_counts() const;
+};
+
+inline size_t VectorGameState::size() const {
+    return d_states.size();
+}
+
+inline GameState &VectorGameState::operator[](size_t idx) {
+    return d_games[idx];
+}
+
+inline GameState const &VectorGameState::operator[](size_t idx) const {
+    return d_games[idx];
+}
+
+inline std::span<State const> VectorGameState::states() const {
+    return d_states;
+}
+
+inline std::span<uint8_t const> VectorGameState::acting_players() const {
+    return d_acting_players;
+}
+
+inline std::span<uint8_t const> VectorGameState::turns_left() const {
+    return d_turns_left;
+}
+
+inline std::span<uint8_t const> VectorGameState::hand_counts() const {
+    return std::span<uint8_t const>(d_counts).first(
+        size() * d_num_players * COUNTS_WIDTH);
+}
+
+inline std::span<uint8_t const> VectorGameState::deck_counts() const {
+    return std::span<uint8_t const>(d_counts).subspan(
+        size() * d_num_players * COUNTS_WIDTH, size() * COUNTS_WIDTH);
+}
+
+inline std::span<uint8_t const> VectorGameState::discard_counts() const {
+    return std::span<uint8_t const>(d_counts).last(size() * COUNTS_WIDTH);
+}
+
+} // namespace exploding_kittens
+
+#endif // EK_VECTOR_GAME_STATE_H
\ No newline at end of file
@@ -0,0 +1,70 @@
+#ifndef EK_ZOBRIST_KEYS_H
+#define EK_ZOBRIST_KEYS_H
+
+#include "card_defs.h"
+#include "game_defs.h"
+#include "../../utils.h"
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+
+
+namespace exploding_kittens {
+
+namespace zobrist_detail {
+
+// Hands never hold more than MAX_CARDS of a card, nor stacks more cards:
+constexpr size_t MAX_COUNT = MAX_CARDS;
+
+using Table = std::array<uint64_t, UNIQUE_CARDS * (MAX_COUNT + 1)>;
+
+constexpr Table make_table(uint64_t salt) {
+    Table table{};
+    for (size_t idx = 0; idx != table.size(); ++idx)
+        table[idx] = tabletop_general::mix64(salt + idx);
+    return table;
+}
+
+inline constexpr Table count_keys = make_table(0x636f756e74ULL);
+inline constexpr Table position_keys = make_table(0x706f73ULL << 40);
+
+} // namespace zobrist_detail
+
+/**
+ * @brief Random keys for Zobrist hashing the card collections, generated at
+ * compile time. A collection's hash is the xor of one key per (card, count)
+ * pair for unordered data, or per (position, card) pair for ordered data, so
+ * a single change is a single xor (or two).
+ */
+struct ZobristKeys {
+
+    static constexpr size_t MAX_COUNT = zobrist_detail::MAX_COUNT;
+
+    /**
+     * @brief Key for holding count copies of card. Zero for count 0, so an
+     * empty collection hashes to zero.
+     */
+    static uint64_t count(size_t card, size_t count);
+
+    /**
+     * @brief Key for card being at position pos (from the bottom) of a stack.
+     */
+    static uint64_t position(size_t pos, CardIdx card);
+};
+
+inline uint64_t ZobristKeys::count(size_t card, size_t count) {
+    assert(count <= MAX_COUNT && "Too many cards to hash.");
+    return count == 0 ? 0 :
+        zobrist_detail::count_keys[card * (MAX_COUNT + 1) + count];
+}
+
+inline uint64_t ZobristKeys::position(size_t pos, CardIdx card) {
+    assert(pos <= MAX_COUNT && "Stack too large to hash.");
+    return zobrist_detail::position_keys[to_uint(card) * (MAX_COUNT + 1) +
+        pos];
+}
+
+} // namespace exploding_kittens
+
+#endif // EK_ZOBRIST_KEYS_H
\ No newline at end of file
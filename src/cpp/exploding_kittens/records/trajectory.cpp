@@ -0,0 +1,231 @@
+#include "trajectory.h"
+#include "../environment/rules.h"
+#include "../environment/game_state_snapshot.h"
+#include "byte_io.ih"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+namespace exploding_kittens {
+
+namespace {
+
+using byte_io::get;
+using byte_io::put;
+
+template <typename Source>
+CardIdx get_card(Source &src) {
+    uint8_t card = get<uint8_t>(src);
+    if (card >= UNIQUE_CARDS)
+        throw std::runtime_error("Invalid card in trajectory record.");
+    return from_uint(card);
+}
+
+// Throws unless the deal uses exactly the cards of a new game, with hands of
+// the dealt size and without kittens. This also bounds every count.
+void check_deal(GameRecord const &record) {
+    std::array<uint8_t, UNIQUE_CARDS> in_deck{}, in_hand{}, random{};
+    initArray<CardInfoField::init_deck>(record.num_players, in_deck.data());
+    initArray<CardInfoField::init_hand>(record.num_players, in_hand.data());
+    initArray<CardInfoField::init_rand>(record.num_players, random.data());
+
+    std::array<size_t, UNIQUE_CARDS> missing{};
+    size_t hand_size = CARDS_2_DEAL;
+    for (uint8_t i = 0; i != UNIQUE_CARDS; ++i) {
+        missing[i] = in_deck[i] + record.num_players * in_hand[i] + random[i];
+        hand_size += in_hand[i];
+    }
+
+    auto take = [&](uint8_t i, size_t n) {
+        if (n > missing[i])
+            throw std::runtime_error("Recorded deal has too many cards.");
+        missing[i] -= n;
+    };
+    for (CardIdx card : record.deck)
+        take(to_uint(card), 1);
+    for (size_t player = 0; player != record.num_players; ++player) {
+        auto const &hand = record.hands[player];
+        if (hand[to_uint(CardIdx::Exploding_Kitten)] != 0 or
+                std::accumulate(hand.begin(), hand.end(), size_t{0}) !=
+                hand_size)
+            throw std::runtime_error("Invalid hand in recorded deal.");
+        for (uint8_t i = 0; i != UNIQUE_CARDS; ++i)
+            take(i, hand[i]);
+    }
+    if (std::any_of(missing.begin(), missing.end(),
+                    [](size_t n) { return n != 0; }))
+        throw std::runtime_error("Recorded deal is missing cards.");
+}
+
+// Reads one record (see TrajectoryWriter for the format).
+template <typename Source>
+void parse(Source &src, GameRecord &record) {
+    record.num_players = get<uint8_t>(src);
+    if (record.num_players < MIN_PLAYERS or record.num_players > MAX_PLAYERS)
+        throw std::runtime_error("Invalid number of players in record.");
+
+    record.deck.resize(get<uint8_t>(src));
+    if (record.deck.size() > MAX_CARDS)
+        throw std::runtime_error("Too many cards in recorded deck.");
+    for (CardIdx &card : record.deck)
+        card = get_card(src);
+
+    record.hands = {};
+    for (size_t player = 0; player != record.num_players; ++player)
+        for (uint8_t n = get<uint8_t>(src); n != 0; --n)
+            ++record.hands[player][to_uint(get_card(src))];
+    check_deal(record);
+
+    record.rng_key = get<uint64_t>(src);
+    record.rng_counter = get<uint64_t>(src);
+
+    record.actions.resize(get<uint16_t>(src));
+    for (ActionCode &code : record.actions) {
+        code = get<uint16_t>(src);
+        if (code >= NUM_ACTION_CODES)
+            throw std::runtime_error("Invalid action code in record.");
+    }
+}
+
+} // namespace
+
+GameRecord GameRecord::start(GameState const &gs) {
+    if (gs.state != State::Default or gs.primary_player != 0 or
+            gs.turns_left != 1 or gs.cards.discard_pile.size() != 0)
+        throw std::invalid_argument("Can only record from the start.");
+    if (gs.cards.deck.is_lazy())
+        throw std::invalid_argument("Can only record games with an ordered "
+                                    "deck (not lazy).");
+
+    GameStateSnapshot snap;
+    gs.save(snap);
+
+    GameRecord record;
+    record.num_players = snap.num_players;
+    record.deck.assign(snap.deck.begin(), snap.deck.begin() + snap.deck_size);
+    std::copy_n(snap.hands.begin(), snap.num_players, record.hands.begin());
+    record.rng_key = gs.rng.key();
+    record.rng_counter = gs.rng.counter();
+    return record;
+}
+
+void GameRecord::record(Action const &a) {
+    actions.push_back(encode_action(a));
+}
+
+void GameRecord::replay(GameState &gs, size_t num_actions) const {
+    if (num_actions == SIZE_MAX)
+        num_actions = actions.size();
+    if (num_actions > actions.size())
+        throw std::out_of_range("Not that many actions in the record.");
+
+    GameStateSnapshot snap;
+    snap.deck_size = deck.size();
+    std::copy(deck.begin(), deck.end(), snap.deck.begin());
+    snap.deck_lazy = false;
+    snap.deck_counts = {};
+    for (CardIdx card : deck)
+        ++snap.deck_counts[to_uint(card)];
+    snap.discard_size = 0;
+    snap.discard_counts = {};
+    snap.deck_known = {};
+    snap.hands = hands;
+    snap.num_players = num_players;
+    snap.state = State::Default;
+    snap.primary_player = 0;
+    snap.turns_left = 1;
+    snap.num_secondaries = 0;
+    snap.is_noped = false;
+    snap.staged_action = Action{};
+    snap.rng.set_key(rng_key);
+    snap.rng.set_counter(rng_counter);
+    gs.restore(snap);
+
+    ActionList legal;
+    for (size_t idx = 0; idx != num_actions; ++idx) {
+        Action const &a = decode_action(actions[idx]);
+        legal.clear();
+        Rules::append_legal_actions(gs, legal);
+        if (std::find(legal.begin(), legal.end(), a) == legal.end())
+            throw std::runtime_error("Illegal action in record.");
+        Rules::take_action(gs, a);
+    }
+}
+
+TrajectoryWriter::TrajectoryWriter(std::ostream &out)
+:
+    d_out(out)
+{
+    d_out.write(TRAJECTORY_MAGIC.data(), TRAJECTORY_MAGIC.size());
+    put<uint8_t>(d_out, TRAJECTORY_VERSION);
+}
+
+void TrajectoryWriter::write(GameRecord const &record) {
+    // Checked up front, so that nothing is written for a bad record:
+    if (record.num_players < MIN_PLAYERS or record.num_players > MAX_PLAYERS or
+            record.deck.size() > MAX_CARDS)
+        throw std::runtime_error("Invalid trajectory record.");
+    for (size_t player = 0; player != record.num_players; ++player)
+        if (std::accumulate(record.hands[player].begin(),
+                record.hands[player].end(), size_t{0}) > MAX_CARDS)
+            throw std::runtime_error("Invalid trajectory record.");
+    if (record.actions.size() > UINT16_MAX)
+        throw std::runtime_error("Too many actions for a trajectory record.");
+
+    put<uint8_t>(d_out, record.num_players);
+
+    put<uint8_t>(d_out, record.deck.size());
+    for (CardIdx card : record.deck)
+        put<uint8_t>(d_out, to_uint(card));
+
+    for (size_t player = 0; player != record.num_players; ++player) {
+        auto const &hand = record.hands[player];
+        uint8_t size = 0;
+        for (uint8_t count : hand)
+            size += count;
+        put<uint8_t>(d_out, size);
+        for (uint8_t card = 0; card != UNIQUE_CARDS; ++card)
+            for (uint8_t n = 0; n != hand[card]; ++n)
+                put<uint8_t>(d_out, card);
+    }
+
+    put<uint64_t>(d_out, record.rng_key);
+    put<uint64_t>(d_out, record.rng_counter);
+
+    put<uint16_t>(d_out, record.actions.size());
+    for (ActionCode code : record.actions)
+        put<uint16_t>(d_out, code);
+
+    if (not d_out)
+        throw std::runtime_error("Could not write trajectory record.");
+}
+
+TrajectoryReader::TrajectoryReader(std::istream &in)
+:
+    d_in(in)
+{
+    std::array<char, 4> magic{};
+    d_in.read(magic.data(), magic.size());
+    if (not d_in or magic != TRAJECTORY_MAGIC)
+        throw std::runtime_error("Not a trajectory file.");
+    byte_io::StreamSource src(d_in);
+    if (get<uint8_t>(src) != TRAJECTORY_VERSION)
+        throw std::runtime_error("Unsupported trajectory format version.");
+}
+
+bool TrajectoryReader::read(GameRecord &record) {
+    if (d_in.peek() == std::istream::traits_type::eof())
+        return false;
+    byte_io::StreamSource src(d_in);
+    parse(src, record);
+    return true;
+}
+
+size_t parse_record(std::span<uint8_t const> bytes, GameRecord &record) {
+    byte_io::MemorySource src(bytes);
+    parse(src, record);
+    return src.position();
+}
+
+} // namespace exploding_kittens
\ No newline at end of file
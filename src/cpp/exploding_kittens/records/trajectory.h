@@ -0,0 +1,129 @@
+#ifndef EK_TRAJECTORY_H
+#define EK_TRAJECTORY_H
+
+#include "../environment/game_state.h"
+#include "../environment/action_codec.h"
+#include "../../utils.h"
+
+#include <array>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <span>
+#include <vector>
+
+
+namespace exploding_kittens {
+
+/**
+ * @brief Everything needed to reproduce a game: the initial deal, the
+ * generator state after dealing, and the actions taken. Replaying is
+ * deterministic, so any intermediate GameState can be rebuilt from it.
+ */
+struct GameRecord {
+    uint8_t num_players = 0;
+    std::vector<CardIdx> deck;      // Bottom to top.
+    std::array<std::array<uint8_t, UNIQUE_CARDS>, MAX_PLAYERS> hands{};
+    uint64_t rng_key = 0;           // See tabletop_general::Rng::key.
+    uint64_t rng_counter = 0;
+    std::vector<ActionCode> actions;
+
+    /**
+     * @brief Start a record of the game in gs, which has to be freshly reset
+     * (with no actions taken yet).
+     * @throws std::invalid_argument if gs is not at the start of a game, or
+     * its deck is lazy (the deal has to be known up front).
+     */
+    static GameRecord start(GameState const &gs);
+
+    /**
+     * @brief Append an action (taken in the recorded game).
+     * @throws std::invalid_argument if the action has no ActionCode.
+     */
+    void record(Action const &a);
+
+    /**
+     * @brief Set gs to the state after the first num_actions actions (all
+     * of them by default).
+     * @throws std::out_of_range if there are fewer actions.
+     * @throws std::runtime_error if an action is illegal where it is taken.
+     */
+    void replay(GameState &gs, size_t num_actions = SIZE_MAX) const;
+
+    bool operator==(GameRecord const &other) const = default;
+};
+
+/**
+ * @brief Writes GameRecords to a binary stream. The stream starts with a
+ * header (magic "EKTR" and a format version), followed by the records back to
+ * back. All integers are little-endian. A record is:
+ *
+ * | Field                            | Bytes                           |
+ * |----------------------------------|---------------------------------|
+ * | num_players                      | 1                               |
+ * | deck size, deck cards            | 1 + 1 per card (bottom to top)  |
+ * | per player: hand size, its cards | 1 + 1 per card (sorted)         |
+ * | rng key, rng counter             | 8 + 8                           |
+ * | number of actions, action codes  | 2 + 2 per action                |
+ *
+ * A two player game takes about 80 + 2 * (number of actions) bytes.
+ */
+class TrajectoryWriter {
+
+    std::ostream &d_out;
+
+    public:
+        /**
+         * @brief Writes the header to out.
+         */
+        explicit TrajectoryWriter(std::ostream &out);
+
+        /**
+         * @brief Append a record.
+         * @throws std::runtime_error if the stream fails, or the record does
+         * not fit the format (then nothing gets written).
+         */
+        void write(GameRecord const &record);
+};
+
+/**
+ * @brief Reads GameRecords written by a TrajectoryWriter.
+ */
+class TrajectoryReader {
+
+    std::istream &d_in;
+
+    public:
+        /**
+         * @brief Reads and checks the header of in.
+         * @throws std::runtime_error if the header or version is wrong.
+         */
+        explicit TrajectoryReader(std::istream &in);
+
+        /**
+         * @brief Read the next record.
+         * @return false if the stream ended cleanly before a record.
+         * @throws std::runtime_error if the record is truncated or invalid.
+         */
+        bool read(GameRecord &record);
+};
+
+/**
+ * @brief Parses one record from memory, e.g. from a mapped trajectory file
+ * (after its header). Like TrajectoryReader::read, it checks that the deal
+ * is one of a new game, but not that the actions are legal (replay does).
+ *
+ * @return The number of bytes the record took.
+ * @throws std::runtime_error if the record is truncated or invalid.
+ */
+size_t parse_record(std::span<uint8_t const> bytes, GameRecord &record);
+
+// The binary format, checked by TrajectoryReader. The header is the magic
+// followed by the version byte.
+constexpr std::array<char, 4> TRAJECTORY_MAGIC = {'E', 'K', 'T', 'R'};
+constexpr uint8_t TRAJECTORY_VERSION = 1;
+constexpr size_t TRAJECTORY_HEADER_SIZE = TRAJECTORY_MAGIC.size() + 1;
+
+} // namespace exploding_kittens
+
+#endif // EK_TRAJECTORY_H
\ No newline at end of file
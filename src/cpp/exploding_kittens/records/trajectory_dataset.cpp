@@ -0,0 +1,234 @@
+#include "trajectory_dataset.h"
+#include "byte_io.ih"
+#include "../environment/rules.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace exploding_kittens {
+
+namespace {
+
+// The index file: magic, version, size of the trajectory file, number of
+// games, then per game its offset (u64) and number of actions (u16).
+constexpr std::array<char, 4> INDEX_MAGIC = {'E', 'K', 'T', 'I'};
+constexpr uint8_t INDEX_VERSION = 1;
+
+std::runtime_error system_error(std::string const &what,
+                                std::string const &path) {
+    return std::runtime_error(what + " '" + path + "': " +
+        std::strerror(errno));
+}
+
+} // namespace
+
+TrajectoryDataset::TrajectoryDataset(std::string const &path) {
+    map(path);
+    scan();
+}
+
+TrajectoryDataset::TrajectoryDataset(std::string const &path,
+                                     std::string const &index_path) {
+    map(path);
+    load_index(index_path);
+}
+
+TrajectoryDataset::Mapping::~Mapping() {
+    if (data != nullptr)
+        munmap(const_cast<uint8_t *>(data), size);
+}
+
+void TrajectoryDataset::map(std::string const &path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+        throw system_error("Cannot open", path);
+    struct stat info;
+    if (fstat(fd, &info) == -1) {
+        close(fd);
+        throw system_error("Cannot stat", path);
+    }
+    size_t size = info.st_size;
+    if (size < TRAJECTORY_HEADER_SIZE) {
+        close(fd);
+        throw std::runtime_error("Not a trajectory file: '" + path + "'.");
+    }
+
+    void *data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);      // The mapping stays valid.
+    if (data == MAP_FAILED)
+        throw system_error("Cannot map", path);
+    d_file.data = static_cast<uint8_t const *>(data);
+    d_file.size = size;
+
+    if (not std::equal(TRAJECTORY_MAGIC.begin(), TRAJECTORY_MAGIC.end(),
+                       d_file.data) or
+            d_file.data[TRAJECTORY_MAGIC.size()] != TRAJECTORY_VERSION)
+        throw std::runtime_error("Not a trajectory file (of this version): '" +
+            path + "'.");
+}
+
+void TrajectoryDataset::scan() {
+    // One sequential pass, after which access is random:
+    madvise(const_cast<uint8_t *>(d_file.data), d_file.size, MADV_SEQUENTIAL);
+
+    GameRecord record;
+    GameState gs;
+    d_first_sample.assign(1, 0);
+    for (size_t pos = TRAJECTORY_HEADER_SIZE; pos != d_file.size; ) {
+        d_offsets.push_back(pos);
+        pos += parse_record({d_file.data + pos, d_file.size - pos}, record);
+        record.replay(gs);      // Checks that every action is legal.
+        if (gs.state != State::Game_Over)
+            throw std::runtime_error("Recorded game does not end.");
+        d_first_sample.push_back(d_first_sample.back() +
+            record.actions.size());
+    }
+
+    madvise(const_cast<uint8_t *>(d_file.data), d_file.size, MADV_RANDOM);
+}
+
+void TrajectoryDataset::save_index(std::string const &path) const {
+    std::ofstream out(path, std::ios::binary);
+    out.write(INDEX_MAGIC.data(), INDEX_MAGIC.size());
+    byte_io::put<uint8_t>(out, INDEX_VERSION);
+    byte_io::put<uint64_t>(out, d_file.size);
+    byte_io::put<uint64_t>(out, num_games());
+    for (size_t game = 0; game != num_games(); ++game) {
+        byte_io::put<uint64_t>(out, d_offsets[game]);
+        byte_io::put<uint16_t>(out,
+            d_first_sample[game + 1] - d_first_sample[game]);
+    }
+    if (not out)
+        throw system_error("Cannot write index", path);
+}
+
+void TrajectoryDataset::load_index(std::string const &path) {
+    std::ifstream in(path, std::ios::binary);
+    if (not in)
+        throw system_error("Cannot open index", path);
+
+    std::array<char, 4> magic{};
+    in.read(magic.data(), magic.size());
+    byte_io::StreamSource src(in);
+    if (not in or magic != INDEX_MAGIC or
+            byte_io::get<uint8_t>(src) != INDEX_VERSION)
+        throw std::runtime_error("Not an index file: '" + path + "'.");
+    if (byte_io::get<uint64_t>(src) != d_file.size)
+        throw std::runtime_error("Index does not match the trajectory file.");
+
+    uint64_t num_games = byte_io::get<uint64_t>(src);
+    d_offsets.resize(num_games);
+    d_first_sample.assign(1, 0);
+    for (uint64_t &offset : d_offsets) {
+        offset = byte_io::get<uint64_t>(src);
+        if (offset < TRAJECTORY_HEADER_SIZE or offset >= d_file.size)
+            throw std::runtime_error("Index does not match the trajectory "
+                                     "file.");
+        d_first_sample.push_back(d_first_sample.back() +
+            byte_io::get<uint16_t>(src));
+    }
+    madvise(const_cast<uint8_t *>(d_file.data), d_file.size, MADV_RANDOM);
+}
+
+void TrajectoryDataset::read_game(size_t idx, GameRecord &record) const {
+    uint64_t pos = d_offsets.at(idx);
+    parse_record({d_file.data + pos, d_file.size - pos}, record);
+}
+
+float TrajectoryDataset::decode_sample(size_t idx, GameRecord &record,
+                                       GameState &gs,
+                                       std::span<float> observation,
+                                       ActionCode &action) const {
+    if (idx >= num_samples())
+        throw std::out_of_range("No such sample.");
+    size_t game = std::upper_bound(d_first_sample.begin(),
+        d_first_sample.end(), idx) - d_first_sample.begin() - 1;
+    size_t step = idx - d_first_sample[game];
+
+    read_game(game, record);
+    if (step >= record.actions.size())     // Only with a loaded index.
+        throw std::runtime_error("Index does not match the trajectory file.");
+    record.replay(gs, step);
+    uint8_t player = gs.acting_player();
+    encode_observation<float>(gs, player, observation);
+    action = record.actions[step];
+
+    // Play out the rest to find the winner. Still checked, as the records
+    // are not replayed when the index is loaded:
+    ActionList legal;
+    for (; step != record.actions.size(); ++step) {
+        Action const &a = decode_action(record.actions[step]);
+        legal.clear();
+        Rules::append_legal_actions(gs, legal);
+        if (std::find(legal.begin(), legal.end(), a) == legal.end())
+            throw std::runtime_error("Illegal action in record.");
+        Rules::take_action(gs, a);
+    }
+    return gs.winner() == player ? 1.0f : -1.0f;
+}
+
+DatasetSampler::DatasetSampler(TrajectoryDataset const &dataset,
+                               size_t num_threads, uint64_t seed)
+:
+    d_dataset(dataset),
+    d_num_threads(num_threads),
+    d_rng(seed)
+{
+    if (num_threads == 0)
+        throw std::invalid_argument("Need at least one thread.");
+    if (dataset.num_samples() == 0)
+        throw std::invalid_argument("Cannot sample from an empty dataset.");
+}
+
+void DatasetSampler::sample(std::span<float> observations,
+                            std::span<ActionCode> actions,
+                            std::span<float> returns) {
+    size_t batch = returns.size();
+    if (actions.size() != batch or observations.size() != batch * OBS_SIZE)
+        throw std::invalid_argument("Output buffers have the wrong size.");
+
+    // Row idx draws from its own stream, so threads don't matter:
+    tabletop_general::Rng batch_rng = d_rng.split(d_batches++);
+    auto decode_rows = [&](size_t begin, size_t end) {
+        GameRecord record;
+        GameState gs;
+        for (size_t idx = begin; idx != end; ++idx) {
+            tabletop_general::Rng rng = batch_rng.split(idx);
+            returns[idx] = d_dataset.decode_sample(
+                rng.below(d_dataset.num_samples()), record, gs,
+                observations.subspan(idx * OBS_SIZE, OBS_SIZE), actions[idx]);
+        }
+    };
+
+    size_t num_threads = std::min(d_num_threads, batch);
+    std::vector<std::exception_ptr> errors(num_threads);
+    {
+        std::vector<std::jthread> threads;
+        for (size_t t = 0; t != num_threads; ++t) {
+            threads.emplace_back([&, t]() {
+                try {
+                    decode_rows(batch * t / num_threads,
+                                batch * (t + 1) / num_threads);
+                } catch (...) {
+                    errors[t] = std::current_exception();
+                }
+            });
+        }
+    }   // jthreads join here.
+
+    for (std::exception_ptr const &error : errors)
+        if (error)
+            std::rethrow_exception(error);
+}
+
+} // namespace exploding_kittens
\ No newline at end of file
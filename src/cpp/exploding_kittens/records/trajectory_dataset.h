@@ -0,0 +1,151 @@
+#ifndef EK_TRAJECTORY_DATASET_H
+#define EK_TRAJECTORY_DATASET_H
+
+#include "trajectory.h"
+#include "../environment/observation.h"
+#include "../../utils.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+
+namespace exploding_kittens {
+
+/**
+ * @brief Random access to the training samples in a trajectory file (as
+ * written by TrajectoryWriter), without loading it: the file is memory-mapped
+ * and only an index of the games is kept in memory (16 bytes per game).
+ *
+ * Every action of every game is a sample: the observation of the player that
+ * took it (in the state before it), the action itself, and the return of
+ * that player: +1 if they won the game, -1 otherwise. Samples are numbered
+ * game by game. Decoding one replays its game, which takes microseconds.
+ *
+ * The index is built by scanning the file once, which also validates every
+ * record by replaying it: the deal, the legality of every action, and that
+ * the game ends. Or it is loaded from an index file written by save_index;
+ * the actions are then only checked as samples get decoded. Reading is
+ * thread-safe.
+ */
+class TrajectoryDataset {
+
+    // The mapped file, unmapped on destruction:
+    struct Mapping {
+        uint8_t const *data = nullptr;
+        size_t size = 0;
+        ~Mapping();
+    } d_file;
+
+    // Per game its offset in the file, and the number of samples before it.
+    // d_first_sample has an extra entry at the end: the total.
+    std::vector<uint64_t> d_offsets;
+    std::vector<uint64_t> d_first_sample;
+
+    public:
+        /**
+         * @brief Maps the trajectory file at path and indexes it.
+         * @throws std::runtime_error if the file cannot be mapped, or holds
+         * an invalid record.
+         */
+        explicit TrajectoryDataset(std::string const &path);
+
+        /**
+         * @brief Maps the trajectory file at path, with the index from
+         * index_path (see save_index) instead of scanning.
+         * @throws std::runtime_error if a file cannot be read, or the index
+         * does not belong to the trajectory file.
+         */
+        TrajectoryDataset(std::string const &path,
+                          std::string const &index_path);
+
+        // Disable copy and move semantics (samplers hold references):
+        TrajectoryDataset(const TrajectoryDataset &) = delete;
+        TrajectoryDataset &operator=(const TrajectoryDataset &) = delete;
+        TrajectoryDataset(TrajectoryDataset &&) = delete;
+        TrajectoryDataset &operator=(TrajectoryDataset &&) = delete;
+
+        /**
+         * @brief Write the index to path, to skip the scan next time.
+         * @throws std::runtime_error if the file cannot be written.
+         */
+        void save_index(std::string const &path) const;
+
+        size_t num_games() const;
+        size_t num_samples() const;
+
+        /**
+         * @brief Parse game idx (idx < num_games()) into record.
+         */
+        void read_game(size_t idx, GameRecord &record) const;
+
+        /**
+         * @brief Decode sample idx (idx < num_samples()).
+         *
+         * @param record, gs Scratch space, to avoid allocations.
+         * @param observation Output. Must have length OBS_SIZE.
+         * @param action Output: the action taken.
+         * @return The return of the player that took the action.
+         * @throws std::runtime_error if the game has an illegal action, or
+         * fewer actions than the index says.
+         */
+        float decode_sample(size_t idx, GameRecord &record, GameState &gs,
+                            std::span<float> observation,
+                            ActionCode &action) const;
+
+    private:
+        // Map the file at path.
+        void map(std::string const &path);
+
+        // Build the index by parsing all records.
+        void scan();
+
+        // Load the index from the file at path.
+        void load_index(std::string const &path);
+};
+
+/**
+ * @brief Draws batches of uniformly random samples from a TrajectoryDataset,
+ * decoding them on a number of threads. The result only depends on the seed
+ * and the number of batches drawn before, not on the number of threads.
+ */
+class DatasetSampler {
+
+    TrajectoryDataset const &d_dataset;
+    size_t d_num_threads;
+    tabletop_general::Rng d_rng;
+    uint64_t d_batches = 0;
+
+    public:
+        /**
+         * @throws std::invalid_argument if num_threads is zero, or the
+         * dataset has no samples.
+         */
+        DatasetSampler(TrajectoryDataset const &dataset, size_t num_threads,
+                       uint64_t seed = 0);
+
+        /**
+         * @brief Draw a batch of B samples (B = returns.size()).
+         *
+         * @param observations Output. Must have length B * OBS_SIZE.
+         * @param actions Output. Must have length B.
+         * @param returns Output.
+         * @throws std::invalid_argument if the lengths do not match.
+         */
+        void sample(std::span<float> observations,
+                    std::span<ActionCode> actions, std::span<float> returns);
+};
+
+inline size_t TrajectoryDataset::num_games() const {
+    return d_offsets.size();
+}
+
+inline size_t TrajectoryDataset::num_samples() const {
+    return d_first_sample.back();
+}
+
+} // namespace exploding_kittens
+
+#endif // EK_TRAJECTORY_DATASET_H
\ No newline at end of file
@@ -0,0 +1,66 @@
+#include "game_scheduler.h"
+
+#include <stdexcept>
+
+namespace exploding_kittens {
+
+GameScheduler::GameScheduler(size_t num_games, size_t num_workers)
+:
+    d_num_workers(num_workers),
+    d_queues(new WorkerQueue[num_workers])
+{
+    if (num_workers == 0)
+        throw std::invalid_argument("Need at least one worker.");
+
+    // Dividing the games as evenly as possible:
+    for (size_t w = 0; w != num_workers; ++w)
+        d_queues[w].remaining = num_games / num_workers +
+            (w < num_games % num_workers ? 1 : 0);
+}
+
+bool GameScheduler::acquire(size_t worker) {
+    if (take_own(worker))
+        return true;
+
+    // Own queue is empty: go around the others, starting at the neighbour.
+    for (size_t offset = 1; offset != d_num_workers; ++offset) {
+        size_t victim = (worker + offset) % d_num_workers;
+        if (steal(worker, victim) and take_own(worker))
+            return true;
+    }
+    return false;
+}
+
+size_t GameScheduler::remaining() const {
+    size_t total = 0;
+    for (size_t w = 0; w != d_num_workers; ++w)
+        total += d_queues[w].remaining.load(std::memory_order_relaxed);
+    return total;
+}
+
+bool GameScheduler::take_own(size_t worker) {
+    std::atomic<size_t> &own = d_queues[worker].remaining;
+    size_t cur = own.load(std::memory_order_relaxed);
+    while (cur != 0) {
+        if (own.compare_exchange_weak(cur, cur - 1, std::memory_order_relaxed))
+            return true;
+    }
+    return false;
+}
+
+bool GameScheduler::steal(size_t worker, size_t victim) {
+    std::atomic<size_t> &other = d_queues[victim].remaining;
+    size_t cur = other.load(std::memory_order_relaxed);
+    while (cur != 0) {
+        size_t loot = (cur + 1) / 2;
+        if (other.compare_exchange_weak(cur, cur - loot,
+                                        std::memory_order_relaxed)) {
+            d_queues[worker].remaining.fetch_add(loot,
+                std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace exploding_kittens
\ No newline at end of file
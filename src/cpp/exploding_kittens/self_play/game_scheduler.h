@@ -0,0 +1,59 @@
+#ifndef EK_GAME_SCHEDULER_H
+#define EK_GAME_SCHEDULER_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+
+namespace exploding_kittens {
+
+/**
+ * @brief Hands out "play one game" tickets to a fixed number of workers. Every
+ * worker starts with an equal share of the tickets in its own queue. A worker
+ * whose queue ran dry steals half of the remaining tickets of another worker,
+ * so no thread sits idle while there are still games left to play.
+ */
+class GameScheduler {
+
+    // Aligned to a cache line each, so workers don't false-share counters.
+    struct alignas(64) WorkerQueue {
+        std::atomic<size_t> remaining{0};
+    };
+
+    size_t d_num_workers;
+    std::unique_ptr<WorkerQueue[]> d_queues;
+
+    public:
+        /**
+         * @param num_games Total number of games to hand out.
+         * @param num_workers Number of workers (threads) that take games.
+         * @throws std::invalid_argument if num_workers is zero.
+         */
+        GameScheduler(size_t num_games, size_t num_workers);
+
+        /**
+         * @brief Take one game for worker. First tries its own queue, then
+         * tries to steal from the others.
+         *
+         * @return true if a game was acquired, false if all games are taken.
+         */
+        bool acquire(size_t worker);
+
+        /**
+         * @return The number of games not handed out yet (approximate while
+         * workers are running).
+         */
+        size_t remaining() const;
+
+    private:
+        // Decrement own counter if non-zero.
+        bool take_own(size_t worker);
+
+        // Move half of victim's tickets (rounded up) into worker's queue.
+        bool steal(size_t worker, size_t victim);
+};
+
+} // namespace exploding_kittens
+
+#endif // EK_GAME_SCHEDULER_H
\ No newline at end of file
@@ -0,0 +1,87 @@
+#include "self_play_runner.h"
+#include "game_scheduler.h"
+
+#include "../environment/vector_game_state.h"
+#include "../../utils.h"
+
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace exploding_kittens {
+
+namespace {
+
+// Everything one worker thread does. Writes its results into out when done
+// (counting in a local object avoids false sharing between the workers).
+void worker_loop(SelfPlayConfig const &config, GameScheduler &scheduler,
+                 size_t worker, SelfPlayStats &out) {
+    SelfPlayStats stats;
+    tabletop_general::Rng rng = tabletop_general::Rng(config.seed).split(worker);
+
+    VectorGameState envs(config.envs_per_thread, config.num_players, rng(),
+                         config.lazy_deck);
+    std::vector<bool> active(envs.size());
+    for (size_t idx = 0; idx != envs.size(); ++idx)
+        active[idx] = scheduler.acquire(worker);
+
+    ActionList legal;
+    bool any_active = true;
+    while (any_active) {
+        any_active = false;
+        for (size_t idx = 0; idx != envs.size(); ++idx) {
+            if (not active[idx])
+                continue;
+            any_active = true;
+
+            legal.clear();
+            envs.append_legal_actions(idx, legal);
+            envs.step(idx, legal[rng.below(legal.size())]);
+            ++stats.steps;
+
+            if (envs.states()[idx] != State::Game_Over)
+                continue;
+
+            ++stats.games;
+            ++stats.wins[envs[idx].winner()];
+            active[idx] = scheduler.acquire(worker);
+            if (active[idx])
+                envs.reset(idx);
+        }
+    }
+    out = stats;
+}
+
+} // namespace
+
+SelfPlayStats run_self_play(SelfPlayConfig const &config) {
+    if (config.num_threads == 0 or config.envs_per_thread == 0)
+        throw std::invalid_argument("Need at least one thread and env.");
+    if (config.num_players < MIN_PLAYERS or config.num_players > MAX_PLAYERS)
+        throw std::invalid_argument("num_players out of legal range.");
+
+    GameScheduler scheduler(config.num_games, config.num_threads);
+    std::vector<SelfPlayStats> per_worker(config.num_threads);
+
+    auto start = std::chrono::steady_clock::now();
+    {
+        std::vector<std::jthread> threads;
+        for (size_t w = 0; w != config.num_threads; ++w)
+            threads.emplace_back(worker_loop, std::cref(config),
+                std::ref(scheduler), w, std::ref(per_worker[w]));
+    }   // jthreads join here.
+    auto stop = std::chrono::steady_clock::now();
+
+    SelfPlayStats total;
+    for (SelfPlayStats const &s : per_worker) {
+        total.games += s.games;
+        total.steps += s.steps;
+        for (size_t p = 0; p != MAX_PLAYERS; ++p)
+            total.wins[p] += s.wins[p];
+    }
+    total.seconds = std::chrono::duration<double>(stop - start).count();
+    return total;
+}
+
+} // namespace exploding_kittens
\ No newline at end of file
@@ -0,0 +1,59 @@
+#ifndef EK_SELF_PLAY_RUNNER_H
+#define EK_SELF_PLAY_RUNNER_H
+
+#include "../environment/game_defs.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace exploding_kittens {
+
+/**
+ * @brief Settings for run_self_play.
+ */
+struct SelfPlayConfig {
+    size_t num_games = 1000;        // Total number of games to play.
+    size_t num_threads = 1;         // Worker threads to play them on.
+    size_t num_players = 2;         // Players per game.
+    size_t envs_per_thread = 64;    // Games each thread steps side by side.
+    uint64_t seed = 0;              // Worker w uses Rng(seed).split(w).
+    bool lazy_deck = false;         // Shuffle decks lazily (CardStack).
+};
+
+/**
+ * @brief What run_self_play reports back.
+ */
+struct SelfPlayStats {
+    size_t games = 0;                       // Number of finished games.
+    size_t steps = 0;                       // Number of actions taken.
+    double seconds = 0.0;                   // Wall clock time.
+    std::array<size_t, MAX_PLAYERS> wins{}; // Games won, per seat.
+
+    double games_per_sec() const;
+    double steps_per_sec() const;
+};
+
+/**
+ * @brief Plays config.num_games games in which every player picks uniformly
+ * random legal actions. Games are divided over config.num_threads threads
+ * through a work-stealing GameScheduler. Every thread owns its own
+ * VectorGameState and random number generator, derived from config.seed.
+ *
+ * @throws std::invalid_argument if num_threads or envs_per_thread is zero, or
+ * if num_players is out of range.
+ */
+SelfPlayStats run_self_play(SelfPlayConfig const &config);
+
+inline double SelfPlayStats::games_per_sec() const {
+    return seconds > 0.0 ? games / seconds : 0.0;
+}
+
+inline double SelfPlayStats::steps_per_sec() const {
+    return seconds > 0.0 ? steps / seconds : 0.0;
+}
+
+} // namespace exploding_kittens
+
+#endif // EK_SELF_PLAY_RUNNER_H
\ No newline at end of file
@@ -1,10 +0,0 @@
-#include "utils.h"
-
-#include <ctime>
-
-namespace tabletop_general
-{
-
-std::mt19937_64 randnum_gen(std::time(0));
-
-} // namespace tabletop_general
\ No newline at end of file
@@ -1,19 +1,163 @@
 // Some simple general functionality that can be used globally withing the
-// project, such as a globally defined random number generator.
+// project, such as the random number generator every environment carries.
 
 #ifndef TABLTETOP_UTILS_H
 #define TABLTETOP_UTILS_H
 
-#include <random>
+#include <cstdint>
+#include <limits>
 
 namespace tabletop_general
 {
 
 /**
- * @brief Only ever use this pseudo random number generator as a source of
- * randomness to ensure deterministic results when seed gets fixed.
+ * @brief The SplitMix64 finalizer: a strong 64-bit bit mixer. Also usable at
+ * compile time, e.g. for generating hash keys.
  */
-extern ::std::mt19937_64 randnum_gen;
+constexpr uint64_t mix64(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Small counter-based pseudo random number generator. The n-th output
+ * is the SplitMix64 finalizer applied to (key + n * golden ratio), so the
+ * whole state is a key and a counter (16 bytes). Satisfies the
+ * UniformRandomBitGenerator requirements, so it works with std::shuffle and
+ * the std distributions.
+ *
+ * Only ever use an Rng (carried by the environment or passed explicitly) as a
+ * source of randomness, to ensure deterministic results when seeds get fixed.
+ */
+class Rng {
+
+    uint64_t d_key;
+    uint64_t d_counter;
+
+    public:
+        using result_type = uint64_t;
+
+        /**
+         * @brief Seeds the generator. A default constructed Rng uses seed 0,
+         * so results are reproducible unless seeded otherwise.
+         */
+        explicit Rng(uint64_t seed = 0);
+
+        /**
+         * @brief Restart the generator from a new seed.
+         */
+        void seed(uint64_t seed);
+
+        /**
+         * @return The next random number.
+         */
+        result_type operator()();
+
+        /**
+         * @return A uniformly distributed number in [0, n). n must be > 0.
+         */
+        uint64_t below(uint64_t n);
+
+        /**
+         * @brief Derive an independent generator for a sub-stream (e.g. one
+         * per game or per thread). Does not advance this generator.
+         */
+        Rng split(uint64_t stream) const;
+
+        /**
+         * @brief The number of outputs generated since seeding. Together with
+         * the seed this fully describes the position in the stream.
+         */
+        uint64_t counter() const;
+
+        /**
+         * @brief Jump to an arbitrary position in the stream in O(1).
+         */
+        void set_counter(uint64_t counter);
+
+        /**
+         * @brief The stream the generator is in (derived from the seed, or
+         * by split). Together with counter() the complete state, e.g. for
+         * saving a generator to disk.
+         */
+        uint64_t key() const;
+
+        /**
+         * @brief Switch to the stream of key (as returned by key()), keeping
+         * the counter.
+         */
+        void set_key(uint64_t key);
+
+        static constexpr result_type min();
+        static constexpr result_type max();
+
+    private:
+        static constexpr uint64_t golden_gamma = 0x9e3779b97f4a7c15ULL;
+
+        static constexpr uint64_t mix(uint64_t z);
+};
+
+constexpr uint64_t Rng::mix(uint64_t z) {
+    return mix64(z);
+}
+
+inline Rng::Rng(uint64_t seed) {
+    this->seed(seed);
+}
+
+inline void Rng::seed(uint64_t seed) {
+    d_key = mix(seed + golden_gamma);
+    d_counter = 0;
+}
+
+inline Rng::result_type Rng::operator()() {
+    return mix(d_key + (++d_counter) * golden_gamma);
+}
+
+inline uint64_t Rng::below(uint64_t n) {
+    // Lemire's nearly divisionless method (exact, rejects the biased tail):
+    unsigned __int128 m = static_cast<unsigned __int128>((*this)()) * n;
+    uint64_t low = static_cast<uint64_t>(m);
+    if (low < n) {
+        uint64_t threshold = -n % n;
+        while (low < threshold) {
+            m = static_cast<unsigned __int128>((*this)()) * n;
+            low = static_cast<uint64_t>(m);
+        }
+    }
+    return static_cast<uint64_t>(m >> 64);
+}
+
+inline Rng Rng::split(uint64_t stream) const {
+    Rng child;
+    child.d_key = mix(d_key ^ mix(stream + golden_gamma));
+    return child;
+}
+
+inline uint64_t Rng::counter() const {
+    return d_counter;
+}
+
+inline void Rng::set_counter(uint64_t counter) {
+    d_counter = counter;
+}
+
+inline uint64_t Rng::key() const {
+    return d_key;
+}
+
+inline void Rng::set_key(uint64_t key) {
+    d_key = key;
+}
+
+constexpr Rng::result_type Rng::min() {
+    return std::numeric_limits<result_type>::min();
+}
+
+constexpr Rng::result_type Rng::max() {
+    return std::numeric_limits<result_type>::max();
+}
 
 } // namespace tabletop_general
 
@@ -0,0 +1,107 @@
+"""Exploding Kittens as a PettingZoo-style multi-agent environment.
+
+All game logic, including resetting finished games, runs in the C++ core
+(the ``_tabletop_rl`` extension module). This module only adapts it to the
+agent-environment-cycle (AEC) API: the agent to act is the game's acting
+player (the primary player, or the secondary player while noping or giving a
+favor), and every agent observes its own view of the game together with a
+mask of its legal actions.
+
+For vectorized rollouts, use ``_tabletop_rl.BatchEnvironment`` with
+``auto_reset=True`` directly: it steps many games per call and never stalls on
+resets.
+"""
+
+import numpy as np
+
+from _tabletop_rl import BatchEnvironment, NUM_ACTION_CODES, OBS_SIZE
+
+try:
+    from gymnasium import spaces
+except ImportError:     # The spaces are only needed by observation_space etc.
+    spaces = None
+
+try:
+    from pettingzoo import AECEnv
+except ImportError:     # Still usable through the same API without it.
+    AECEnv = object
+
+
+class ExplodingKittensEnv(AECEnv):
+    """A single game of Exploding Kittens for the PettingZoo AEC API.
+
+    Observations are dicts with an ``"observation"`` (float32, OBS_SIZE) and
+    an ``"action_mask"`` (uint8, NUM_ACTION_CODES). Actions are codes of the
+    flat action space. The winner gets a reward of +1 and all other players
+    -1, when the game ends.
+    """
+
+    metadata = {"name": "exploding_kittens_v0", "is_parallelizable": False}
+
+    def __init__(self, num_players=2, seed=0):
+        super().__init__()
+        self.possible_agents = [f"player_{p}" for p in range(num_players)]
+        self._env = BatchEnvironment(1, num_players, seed)
+        self._no_mask = np.zeros(NUM_ACTION_CODES, dtype=np.uint8)
+        self._action = np.zeros(1, dtype=np.int64)
+
+    def observation_space(self, agent):
+        return spaces.Dict({
+            "observation": spaces.Box(0, np.inf, (OBS_SIZE,), np.float32),
+            "action_mask": spaces.Box(0, 1, (NUM_ACTION_CODES,), np.uint8),
+        })
+
+    def action_space(self, agent):
+        return spaces.Discrete(NUM_ACTION_CODES)
+
+    def reset(self, seed=None, options=None):
+        if seed is not None:
+            self._env = BatchEnvironment(1, len(self.possible_agents), seed)
+        self._env.reset()
+        self.agents = list(self.possible_agents)
+        self.rewards = {agent: 0.0 for agent in self.agents}
+        self._cumulative_rewards = {agent: 0.0 for agent in self.agents}
+        self.terminations = {agent: False for agent in self.agents}
+        self.truncations = {agent: False for agent in self.agents}
+        self.infos = {agent: {} for agent in self.agents}
+        self._select_agent()
+
+    def observe(self, agent):
+        player = self.possible_agents.index(agent)
+        acting = agent == self.agent_selection and not self._env.dones[0]
+        return {
+            "observation": self._env.observe(0, player),
+            "action_mask": self._env.masks[0].copy() if acting
+                           else self._no_mask.copy(),
+        }
+
+    def step(self, action):
+        agent = self.agent_selection
+        if self.terminations[agent] or self.truncations[agent]:
+            # Finished agents must step None; they leave the game in turn.
+            self.agents.remove(agent)
+            if self.agents:
+                self.agent_selection = self.agents[0]
+            return
+
+        self._action[0] = action
+        self._env.step(self._action)
+        self._cumulative_rewards[agent] = 0.0
+        for player, a in enumerate(self.possible_agents):
+            self.rewards[a] = float(self._env.rewards[0, player])
+            self._cumulative_rewards[a] += self.rewards[a]
+        if self._env.dones[0]:
+            self.terminations = {a: True for a in self.agents}
+        self._select_agent()
+
+    def last(self, observe=True):
+        agent = self.agent_selection
+        return (self.observe(agent) if observe else None,
+                self._cumulative_rewards[agent], self.terminations[agent],
+                self.truncations[agent], self.infos[agent])
+
+    def _select_agent(self):
+        if self._env.dones[0]:
+            self.agent_selection = self.agents[0]
+        else:
+            self.agent_selection = self.possible_agents[self._env.agents[0]]
\ No newline at end of file
@@ -1,6 +1,23 @@
+#include "exploding_kittens/self_play/self_play_runner.h"
+
+#include <algorithm>
+#include <cstdlib>
 #include <iostream>
+#include <thread>
+
 
+// Usage: experiments [num_games] [num_threads] [num_players]
+int main(int argc, char **argv) {
+    exploding_kittens::SelfPlayConfig config;
+    config.num_games = argc > 1 ? std::atoll(argv[1]) : 100000;
+    config.num_threads = argc > 2 ? std::atoll(argv[2]) :
+        std::max(1U, std::thread::hardware_concurrency());
+    config.num_players = argc > 3 ? std::atoll(argv[3]) : 2;
 
-int main() {
-    std::cout << "This is an experiment file." << std::endl;
+    auto stats = exploding_kittens::run_self_play(config);
+    std::cout << "Played " << stats.games << " games (" << stats.steps
+        << " steps) on " << config.num_threads << " thread(s) in "
+        << stats.seconds << "s.\n"
+        << "  games/sec: " << stats.games_per_sec() << '\n'
+        << "  steps/sec: " << stats.steps_per_sec() << std::endl;
 }
\ No newline at end of file
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include "../environment/testing_utils.h"
+
+#include "exploding_kittens/agents/determinization.h"
+#include "exploding_kittens/environment/rules.h"
+
+#include <stdexcept>
+#include <vector>
+
+namespace exploding_kittens {
+
+// Player 0 places the kitten back at depth 2, so it knows where it is. After
+// that, player 0 holds a Skip and player 1 three Cat_1's.
+static void known_kitten_setup(GameState &g) {
+    defuse_state_reset(g, 2, [](Cards &c) {
+        c.hands[0].counts()[to_uint(CardIdx::Skip)] = 1U;
+        c.hands[1].counts()[to_uint(CardIdx::Cat_1)] = 3U;
+        c.deck.counts()[to_uint(CardIdx::Cat_2)] = 4U;
+        c.deck.counts()[to_uint(CardIdx::Nope)] = 2U;
+        c.discard_pile.counts()[to_uint(CardIdx::Attack)] = 1U;
+    });
+    Rules::take_action(g, Action{ActionEnum::Play_Defuse, {}, 2, 0});
+}
+
+TEST(DeterminizationTests, KeepsWhatTheObserverKnows) {
+    GameState g;
+    known_kitten_setup(g);
+    GameStateSnapshot truth;
+    g.save(truth);
+
+    Determinizer infoset(truth, 0);
+    tabletop_general::Rng rng(1);
+    std::vector<GameStateSnapshot> samples(500);
+    infoset.sample(rng, samples);
+
+    size_t hands_changed = 0;
+    for (GameStateSnapshot const &s : samples) {
+        ASSERT_EQ(s.deck_size, truth.deck_size);
+        EXPECT_EQ(s.deck[s.deck_size - 3], CardIdx::Exploding_Kitten)
+            << "Observer placed the kitten there.";
+        EXPECT_EQ(s.hands[0], truth.hands[0]) << "Own hand is known.";
+        EXPECT_EQ(s.discard_counts, truth.discard_counts);
+
+        // Same cards overall, same hand size:
+        std::array<uint8_t, UNIQUE_CARDS> deck_counts{};
+        for (uint8_t pos = 0; pos != s.deck_size; ++pos)
+            ++deck_counts[to_uint(s.deck[pos])];
+        EXPECT_EQ(deck_counts, s.deck_counts);
+        size_t hand_size = 0;
+        for (uint8_t i = 0; i != UNIQUE_CARDS; ++i) {
+            hand_size += s.hands[1][i];
+            EXPECT_EQ(s.deck_counts[i] + s.hands[1][i],
+                truth.deck_counts[i] + truth.hands[1][i]);
+        }
+        EXPECT_EQ(hand_size, 3);
+        hands_changed += s.hands[1] != truth.hands[1];
+    }
+    EXPECT_GT(hands_changed, 400) << "The opponent's hand is hidden.";
+
+    // Player 1 does not know where the kitten is:
+    Determinizer other(truth, 1);
+    size_t kitten_elsewhere = 0;
+    for (size_t it = 0; it != 100; ++it) {
+        GameStateSnapshot s;
+        other.sample(rng, s);
+        kitten_elsewhere +=
+            s.deck[s.deck_size - 3] != CardIdx::Exploding_Kitten;
+    }
+    EXPECT_GT(kitten_elsewhere, 50);
+}
+
+TEST(DeterminizationTests, LazyDeckHidesWhatOthersPlaced) {
+    GameState g;
+    known_kitten_setup(g);
+    g.cards.deck.forget_unknown();  // Only the kitten stays resolved.
+    GameStateSnapshot truth;
+    g.save(truth);
+    ASSERT_EQ(truth.deck[truth.deck_size - 3], CardIdx::Exploding_Kitten);
+
+    // Player 1 does not know where player 0 put the kitten:
+    Determinizer other(truth, 1);
+    tabletop_general::Rng rng(3);
+    for (size_t it = 0; it != 500; ++it) {
+        GameStateSnapshot s;
+        other.sample(rng, s);
+        for (uint8_t pos = 0; pos != s.deck_size; ++pos)
+            ASSERT_EQ(s.deck[pos], CardIdx::Unresolved);
+        EXPECT_EQ(s.deck_counts[to_uint(CardIdx::Exploding_Kitten)], 1)
+            << "A kitten is never dealt into a hand.";
+
+        // Every card once, and the unresolved counts cover the whole deck:
+        GameState d;
+        d.restore(s);
+        uint8_t const *unresolved = d.cards.deck.unresolved_counts();
+        for (uint8_t i = 0; i != UNIQUE_CARDS; ++i) {
+            EXPECT_EQ(unresolved[i], s.deck_counts[i]);
+            EXPECT_EQ(s.deck_counts[i] + s.hands[0][i],
+                truth.deck_counts[i] + truth.hands[0][i]);
+        }
+        EXPECT_EQ(count_total(unresolved), s.deck_size);
+    }
+
+    // Player 0 still knows it:
+    Determinizer own(truth, 0);
+    GameStateSnapshot s;
+    own.sample(rng, s);
+    EXPECT_EQ(s.deck[s.deck_size - 3], CardIdx::Exploding_Kitten);
+    EXPECT_EQ(s.deck[s.deck_size - 1], CardIdx::Unresolved);
+}
+
+TEST(DeterminizationTests, HandKnowledgeAndUniformity) {
+    GameState g;
+    known_kitten_setup(g);
+    GameStateSnapshot truth;
+    g.save(truth);
+
+    HandKnowledge knowledge;
+    knowledge.in_hand[1][to_uint(CardIdx::Cat_1)] = 1;
+    Determinizer infoset(truth, 0, knowledge);
+
+    // The unknown cards: the deck apart from the kitten, and two Cat_1's.
+    std::array<size_t, UNIQUE_CARDS> pool{};
+    for (uint8_t pos = 0; pos != truth.deck_size; ++pos)
+        if (pos != truth.deck_size - 3)
+            ++pool[to_uint(truth.deck[pos])];
+    pool[to_uint(CardIdx::Cat_1)] += 2;     // The unknown ones in hand.
+    size_t pool_size = 0;
+    for (size_t n : pool)
+        pool_size += n;
+
+    tabletop_general::Rng rng(2);
+    constexpr size_t num_samples = 20000;
+    std::array<size_t, UNIQUE_CARDS> on_top{};
+    for (size_t it = 0; it != num_samples; ++it) {
+        GameStateSnapshot s;
+        infoset.sample(rng, s);
+        ASSERT_GE(s.hands[1][to_uint(CardIdx::Cat_1)], 1)
+            << "A card known to be in the hand stays there.";
+        ++on_top[to_uint(s.deck[s.deck_size - 1])];
+    }
+    for (uint8_t i = 0; i != UNIQUE_CARDS; ++i) {
+        double expected = static_cast<double>(pool[i]) / pool_size;
+        EXPECT_NEAR(static_cast<double>(on_top[i]) / num_samples, expected,
+            0.015) << "Card " << int(i) << " on top of the deck.";
+    }
+
+    knowledge.in_hand[1][to_uint(CardIdx::Nope)] = 1;
+    EXPECT_THROW(Determinizer(truth, 0, knowledge), std::invalid_argument)
+        << "Player 1 has no Nope.";
+    EXPECT_THROW(Determinizer(truth, 2), std::invalid_argument);
+}
+
+} // namespace exploding_kittens
\ No newline at end of file
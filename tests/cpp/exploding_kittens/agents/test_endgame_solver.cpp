@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include "../environment/testing_utils.h"
+
+#include "exploding_kittens/agents/endgame_solver.h"
+#include "exploding_kittens/environment/rules.h"
+
+#include <stdexcept>
+
+namespace exploding_kittens {
+
+TEST(EndgameSolverTests, CoinFlipEndgame) {
+    // One kitten and one Skip, no defuses: whoever draws the kitten loses.
+    GameState g;
+    custom_state_reset(g, 2, [](Cards &c) {
+        c.deck.counts()[to_uint(CardIdx::Exploding_Kitten)] = 1U;
+        c.deck.counts()[to_uint(CardIdx::Skip)] = 1U;
+    });
+    EndgameSolver solver;
+    WinProbabilities p = solver.solve(g);
+    EXPECT_NEAR(p[0], 0.5, 1e-6);
+    EXPECT_NEAR(p[1], 0.5, 1e-6);
+
+    // With three Skips, player 0 only loses if the kitten is 1st or 3rd:
+    custom_state_reset(g, 2, [](Cards &c) {
+        c.deck.counts()[to_uint(CardIdx::Exploding_Kitten)] = 1U;
+        c.deck.counts()[to_uint(CardIdx::Skip)] = 3U;
+    });
+    p = solver.solve(g);
+    EXPECT_NEAR(p[0], 0.5, 1e-6);
+
+    // Player 1 has a defuse, so player 0 can only win if it is never the one
+    // to draw the kitten: impossible with a single card left after it.
+    custom_state_reset(g, 2, [](Cards &c) {
+        c.hands[1].counts()[to_uint(CardIdx::Defuse)] = 1U;
+        c.deck.counts()[to_uint(CardIdx::Exploding_Kitten)] = 1U;
+        c.deck.counts()[to_uint(CardIdx::Skip)] = 1U;
+    });
+    p = solver.solve(g);
+    EXPECT_NEAR(p[0], 0.0, 1e-6) << "Player 1 defuses it and puts it on top.";
+}
+
+TEST(EndgameSolverTests, PutsKittenWhereOpponentDraws) {
+    GameState g;
+    defuse_state_reset(g, 2, [](Cards &c) {
+        c.deck.counts()[to_uint(CardIdx::Skip)] = 3U;
+    });
+
+    EndgameSolver solver;
+    WinProbabilities values{};
+    Action best = solver.best_action(g, &values);
+    EXPECT_EQ(best.type, ActionEnum::Play_Defuse);
+    EXPECT_EQ(best.arg1, 0) << "On top, so player 1 draws it next.";
+    EXPECT_NEAR(values[0], 1.0, 1e-6);
+    EXPECT_EQ(g.state, State::Defuse) << "The state itself is not altered.";
+}
+
+TEST(EndgameSolverTests, MemoizesAndKeepsTheState) {
+    GameState g;
+    g.seed(21);
+    g.reset(2);
+    ActionList legal;
+    while (g.cards.deck.size() > 10) {
+        legal.clear();
+        Rules::append_legal_actions(g, legal);
+        Rules::take_action(g, legal[g.rng.below(legal.size())]);
+    }
+    ASSERT_NE(g.state, State::Game_Over);
+    uint64_t hash = g.hash();
+
+    EndgameSolver solver;
+    WinProbabilities first = solver.solve(g);
+    EXPECT_NEAR(first[0] + first[1], 1.0, 1e-6);
+    EXPECT_EQ(g.hash(), hash);
+
+    size_t nodes = solver.nodes();
+    EXPECT_GT(nodes, 0);
+    WinProbabilities second = solver.solve(g);
+    EXPECT_EQ(solver.nodes(), nodes) << "Everything should be in the table.";
+    EXPECT_EQ(second, first) << "Memoized in full precision.";
+    solver.clear();
+    EXPECT_EQ(solver.solve(g), first);
+    EXPECT_EQ(solver.nodes(), 2 * nodes);
+
+    EndgameSolver small(EndgameConfig{5});
+    EXPECT_THROW(small.solve(g), std::invalid_argument);
+}
+
+} // namespace exploding_kittens
\ No newline at end of file
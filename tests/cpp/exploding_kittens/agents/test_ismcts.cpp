@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include "../environment/testing_utils.h"
+
+#include "exploding_kittens/agents/ismcts.h"
+#include "exploding_kittens/environment/game_state.h"
+
+#include <stdexcept>
+
+namespace exploding_kittens {
+
+TEST(IsmctsTests, SingleLegalActionReturnedDirectly) {
+    GameState g;
+    g.reset(3);
+    Ismcts mcts;
+    Action a = mcts.search(g);
+    EXPECT_EQ(a.type, ActionEnum::Draw) << "Drawing is the only legal action.";
+    EXPECT_EQ(mcts.root_children().size(), 1);
+}
+
+TEST(IsmctsTests, SearchDoesNotAlterState) {
+    GameState g;
+    kitten_parity_reset(g);
+    uint64_t hash = g.hash();
+
+    IsmctsConfig config;
+    config.iterations = 500;
+    Ismcts mcts(config);
+    mcts.search(g);
+    EXPECT_EQ(g.hash(), hash) << "Searching works on a copy of the state.";
+    EXPECT_EQ(mcts.root_children().size(), g.cards.deck.size() + 1)
+        << "With 500 iterations, every defuse position should be tried.";
+}
+
+TEST(IsmctsTests, FindsWinningKittenPlacement) {
+    GameState g;
+    kitten_parity_reset(g);
+
+    IsmctsConfig config;
+    config.iterations = 2000;
+    config.seed = 7;
+    Ismcts mcts(config);
+    Action a = mcts.search(g);
+
+    ASSERT_EQ(a.type, ActionEnum::Play_Defuse);
+    EXPECT_EQ(a.arg1 % 2, 0)
+        << "Placing the kitten at an even depth makes player 1 draw it.";
+
+    for (auto const &child : mcts.root_children()) {
+        if (child.visits == 0)
+            continue;
+        double win_rate = child.reward / child.visits;
+        if (child.action.arg1 % 2 == 0)
+            EXPECT_DOUBLE_EQ(win_rate, 1.0) << "Even depths always win.";
+        else
+            EXPECT_DOUBLE_EQ(win_rate, 0.0) << "Odd depths always lose.";
+    }
+}
+
+TEST(IsmctsTests, ArenaRespectsMaxNodes) {
+    GameState g;
+    kitten_parity_reset(g);
+
+    IsmctsConfig config;
+    config.iterations = 1000;
+    config.max_nodes = 4;
+    Ismcts mcts(config);
+    mcts.search(g);
+    EXPECT_LE(mcts.tree_size(), 4) << "The tree should stop growing.";
+}
+
+TEST(IsmctsTests, InvalidConfigThrows) {
+    IsmctsConfig config;
+    config.iterations = 0;
+    EXPECT_THROW(Ismcts{config}, std::invalid_argument);
+    config.iterations = 1;
+    config.max_nodes = 1;
+    EXPECT_THROW(Ismcts{config}, std::invalid_argument);
+}
+
+} // namespace exploding_kittens
\ No newline at end of file
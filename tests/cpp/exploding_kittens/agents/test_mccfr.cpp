@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include "../environment/testing_utils.h"
+
+#include "exploding_kittens/agents/mccfr.h"
+#include "exploding_kittens/environment/rules.h"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace exploding_kittens {
+
+TEST(MccfrTests, InfosetKeysFollowObservations) {
+    GameState g;
+    g.seed(2);
+    g.reset(3);
+    uint64_t key = infoset_key(g, 0);
+    EXPECT_EQ(infoset_key(g, 0), key);
+    EXPECT_NE(infoset_key(g, 1), key) << "Another player sees another hand.";
+
+    // Reordering the unknown deck does not change what player 0 sees:
+    auto deck = g.cards.deck.get_top_n(1000);
+    std::reverse(deck.begin(), deck.end());
+    g.cards.deck.rehash();
+    EXPECT_EQ(infoset_key(g, 0), key);
+}
+
+TEST(MccfrTests, LearnsWhereToPutTheKitten) {
+    // Player 0 defuses, with three Skips in the deck and no defuse left for
+    // player 1: on top (or under two cards) wins, the other places lose.
+    GameState g;
+    defuse_state_reset(g, 2, [](Cards &c) {
+        c.deck.counts()[to_uint(CardIdx::Skip)] = 3U;
+    });
+
+    Mccfr mccfr(MccfrConfig{2, 2, 1 << 20});
+    mccfr.run(g, 200);
+    EXPECT_EQ(mccfr.iterations(), 200);
+
+    ActionList legal;
+    Rules::append_legal_actions(g, legal);
+    std::vector<double> strategy(legal.size());
+    ASSERT_TRUE(mccfr.average_strategy(g, legal, strategy));
+    EXPECT_NEAR(std::accumulate(strategy.begin(), strategy.end(), 0.0), 1.0,
+                1e-9);
+    EXPECT_LT(strategy[1] + strategy[3], 0.1) << "Depths 1 and 3 lose.";
+}
+
+TEST(MccfrTests, FullGamesOnManyThreads) {
+    Mccfr mccfr(MccfrConfig{3, 4, 1 << 22, 4, 7});
+    mccfr.run(50);
+    EXPECT_EQ(mccfr.iterations(), 50);
+    EXPECT_GT(mccfr.table().size(), 0) << "Defuse decisions got stored.";
+
+    EXPECT_THROW(Mccfr(MccfrConfig{1}), std::invalid_argument);
+    EXPECT_THROW(Mccfr(MccfrConfig{2, 0}), std::invalid_argument);
+}
+
+TEST(MccfrTests, WorkerErrorsReachTheCaller) {
+    // Rules has no actions for Favor yet, so every worker throws.
+    GameState g;
+    defuse_state_reset(g, 2, [](Cards &) {});
+    g.state = State::Favor;
+
+    Mccfr mccfr(MccfrConfig{2, 4, 1 << 20});
+    EXPECT_THROW(mccfr.run(g, 20), std::logic_error);
+    EXPECT_EQ(mccfr.iterations(), 0);
+}
+
+} // namespace exploding_kittens
\ No newline at end of file
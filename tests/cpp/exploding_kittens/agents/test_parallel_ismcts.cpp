@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include "../environment/testing_utils.h"
+
+#include "exploding_kittens/agents/parallel_ismcts.h"
+#include "exploding_kittens/environment/game_state.h"
+
+namespace exploding_kittens {
+
+static void check_search(Parallelism mode, size_t threads) {
+    GameState g;
+    kitten_parity_reset(g);
+    uint64_t hash = g.hash();
+
+    ParallelIsmctsConfig config;
+    config.search.iterations = 3000;
+    config.search.seed = 11;
+    config.num_threads = threads;
+    config.mode = mode;
+    ParallelIsmcts mcts(config);
+    Action a = mcts.search(g);
+
+    EXPECT_EQ(g.hash(), hash) << "Searching works on copies of the state.";
+    ASSERT_EQ(a.type, ActionEnum::Play_Defuse);
+    EXPECT_EQ(a.arg1 % 2, 0) << "An even depth should be chosen.";
+
+    size_t visits = 0;
+    for (auto const &child : mcts.root_children())
+        visits += child.visits;
+    EXPECT_EQ(visits, 3000) << "Every iteration goes through one root child.";
+    EXPECT_EQ(mcts.root_children().size(), g.cards.deck.size() + 1)
+        << "Children for the same action should be merged / not duplicated.";
+}
+
+TEST(ParallelIsmctsTests, RootParallel) {
+    for (size_t threads = 1; threads <= 4; ++threads)
+        check_search(Parallelism::Root, threads);
+}
+
+TEST(ParallelIsmctsTests, TreeParallel) {
+    for (size_t threads = 1; threads <= 4; ++threads)
+        check_search(Parallelism::Tree, threads);
+}
+
+TEST(ParallelIsmctsTests, TreeModeRespectsMaxNodes) {
+    GameState g;
+    kitten_parity_reset(g);
+
+    ParallelIsmctsConfig config;
+    config.search.iterations = 500;
+    config.search.max_nodes = 3;
+    config.num_threads = 2;
+    config.mode = Parallelism::Tree;
+    ParallelIsmcts mcts(config);
+    mcts.search(g);
+    EXPECT_LE(mcts.root_children().size(), 2) << "Only room for 2 children.";
+}
+
+TEST(ParallelIsmctsTests, ZeroThreadsThrows) {
+    ParallelIsmctsConfig config;
+    config.num_threads = 0;
+    EXPECT_THROW(ParallelIsmcts{config}, std::invalid_argument);
+}
+
+TEST(ParallelIsmctsTests, InvalidSearchesThrow) {
+    ParallelIsmctsConfig config;
+    config.num_threads = 4;
+    config.search.iterations = 3;
+    EXPECT_THROW(ParallelIsmcts{config}, std::invalid_argument)
+        << "Root mode: a thread without iterations.";
+    config.mode = Parallelism::Tree;
+    EXPECT_NO_THROW(ParallelIsmcts{config});
+    config.search.iterations = 0;
+    EXPECT_THROW(ParallelIsmcts{config}, std::invalid_argument);
+
+    // No legal actions once the game is over, thrown on the calling thread:
+    GameState g;
+    kitten_parity_reset(g);
+    g.state = State::Game_Over;
+    config.search.iterations = 100;
+    for (Parallelism mode : {Parallelism::Root, Parallelism::Tree}) {
+        config.mode = mode;
+        ParallelIsmcts mcts(config);
+        EXPECT_THROW(mcts.search(g), std::invalid_argument);
+    }
+}
+
+} // namespace exploding_kittens
\ No newline at end of file
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+
+#include "exploding_kittens/agents/regret_table.h"
+#include "utils.h"
+
+#include <thread>
+#include <vector>
+
+namespace exploding_kittens {
+
+TEST(RegretTableTests, InsertAndFind) {
+    RegretTable table(1 << 16);
+    EXPECT_LE(table.bytes(), 1 << 16) << "Stays within the budget.";
+    EXPECT_EQ(table.find(42), nullptr);
+
+    float *block = table.find_or_insert(42, 3);
+    ASSERT_NE(block, nullptr);
+    for (size_t idx = 0; idx != 6; ++idx)
+        EXPECT_EQ(block[idx], 0.0f) << "Regrets and sums start at zero.";
+    RegretTable::add(block + 1, 2.5f);
+    RegretTable::add(block + 1, 1.0f);
+
+    EXPECT_EQ(table.find_or_insert(42, 3), block) << "Found, not added.";
+    ASSERT_EQ(table.find(42), block);
+    EXPECT_EQ(RegretTable::load(table.find(42) + 1), 3.5f);
+    EXPECT_EQ(table.size(), 1);
+
+    EXPECT_NE(table.find_or_insert(0, 2), nullptr) << "Key 0 works too.";
+    EXPECT_NE(table.find(0), block);
+}
+
+TEST(RegretTableTests, BoundedWhenFull) {
+    RegretTable table(1000, 2);
+    size_t stored = 0;
+    for (uint64_t key = 1; key != 10000; ++key)
+        stored += table.find_or_insert(key * 0x9e3779b97f4a7c15ULL, 2) !=
+                  nullptr;
+    EXPECT_EQ(stored, table.size());
+    EXPECT_LE(table.size(), table.capacity());
+    EXPECT_GT(table.size(), 0);
+    EXPECT_LE(table.bytes(), 1000) << "No growing beyond the budget.";
+}
+
+TEST(RegretTableTests, ConcurrentInsertsAgree) {
+    RegretTable table(1 << 20);
+    constexpr size_t num_threads = 4;
+    std::vector<std::vector<float *>> blocks(num_threads,
+                                             std::vector<float *>(2000));
+    {
+        std::vector<std::jthread> threads;
+        for (size_t t = 0; t != num_threads; ++t) {
+            threads.emplace_back([&, t]() {
+                for (uint64_t key = 0; key != 2000; ++key)
+                    blocks[t][key] = table.find_or_insert(
+                        tabletop_general::mix64(key), 2);
+            });
+        }
+    }
+    EXPECT_EQ(table.size(), 2000) << "Every key is stored exactly once.";
+    for (uint64_t key = 0; key != 2000; ++key) {
+        float const *block = table.find(tabletop_general::mix64(key));
+        ASSERT_NE(block, nullptr);
+        for (size_t t = 0; t != num_threads; ++t)
+            EXPECT_TRUE(blocks[t][key] == nullptr or blocks[t][key] == block)
+                << "Threads either got the block, or saw it unpublished.";
+    }
+}
+
+} // namespace exploding_kittens
\ No newline at end of file
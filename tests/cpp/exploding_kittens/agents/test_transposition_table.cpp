@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include "exploding_kittens/agents/transposition_table.h"
+#include "utils.h"
+
+#include <thread>
+#include <vector>
+
+namespace exploding_kittens {
+
+TEST(TranspositionTableTests, SizedByMemoryBudget) {
+    TranspositionTable tt(1000);
+    EXPECT_EQ(tt.bytes(), 512) << "Largest power of two of buckets that fits.";
+    EXPECT_EQ(tt.capacity(), 32);
+    EXPECT_EQ(tt.fill_rate(), 0.0);
+
+    TranspositionTable tiny(1);
+    EXPECT_EQ(tiny.capacity(), 4) << "At least one bucket.";
+}
+
+TEST(TranspositionTableTests, StoreAndProbe) {
+    TranspositionTable tt(1 << 16);
+    TTValue v{};
+    EXPECT_FALSE(tt.probe(12345, v)) << "Nothing stored yet.";
+
+    tt.store(12345, TTValue{0.5f, 3, 1, 0});
+    ASSERT_TRUE(tt.probe(12345, v));
+    EXPECT_EQ(v.value, 0.5f);
+    EXPECT_EQ(v.depth, 3);
+    EXPECT_EQ(v.flags, 1);
+    EXPECT_FALSE(tt.probe(12345 + tt.capacity(), v))
+        << "Same bucket, different key: no hit.";
+
+    tt.clear();
+    EXPECT_FALSE(tt.probe(12345, v)) << "Clearing removes everything.";
+}
+
+TEST(TranspositionTableTests, DepthReplacement) {
+    TranspositionTable tt(64, Replacement::Depth);   // A single bucket.
+    TTValue v{};
+
+    tt.store(1, TTValue{1.0f, 10, 0, 0});
+    tt.store(1, TTValue{2.0f, 5, 0, 0});
+    ASSERT_TRUE(tt.probe(1, v));
+    EXPECT_EQ(v.value, 1.0f) << "A shallower result should not overwrite.";
+
+    // Fill the bucket, then add one more: the shallowest entry goes.
+    for (uint64_t key = 2; key != 5; ++key)
+        tt.store(key, TTValue{0.0f, static_cast<uint16_t>(key), 0, 0});
+    tt.store(5, TTValue{0.0f, 7, 0, 0});
+    EXPECT_FALSE(tt.probe(2, v)) << "Depth 2 was the shallowest.";
+    EXPECT_TRUE(tt.probe(1, v));
+    EXPECT_TRUE(tt.probe(5, v));
+
+    // In a new generation, old deep entries can be replaced:
+    tt.new_generation();
+    tt.store(1, TTValue{3.0f, 5, 0, 0});
+    ASSERT_TRUE(tt.probe(1, v));
+    EXPECT_EQ(v.value, 3.0f) << "Entries from old searches are outdated.";
+    EXPECT_EQ(v.generation, 1);
+}
+
+TEST(TranspositionTableTests, AlwaysReplacement) {
+    TranspositionTable tt(64, Replacement::Always);
+    TTValue v{};
+    tt.store(1, TTValue{1.0f, 10, 0, 0});
+    tt.store(1, TTValue{2.0f, 5, 0, 0});
+    ASSERT_TRUE(tt.probe(1, v));
+    EXPECT_EQ(v.value, 2.0f) << "Always means always.";
+
+    for (uint64_t key = 2; key != 100; ++key)
+        tt.store(key, TTValue{static_cast<float>(key), 0, 0, 0});
+    EXPECT_TRUE(tt.probe(99, v)) << "The newest entry is always there.";
+    EXPECT_EQ(tt.fill_rate(), 1.0);
+}
+
+TEST(TranspositionTableTests, ConcurrentAccessNeverGivesWrongValues) {
+    TranspositionTable tt(1 << 12);
+    constexpr size_t num_threads = 4;
+    std::vector<size_t> wrong(num_threads);
+
+    {
+        std::vector<std::jthread> threads;
+        for (size_t t = 0; t != num_threads; ++t) {
+            threads.emplace_back([&, t]() {
+                tabletop_general::Rng rng(t);
+                TTValue v{};
+                for (size_t it = 0; it != 100000; ++it) {
+                    // Few keys, so threads collide all the time:
+                    uint64_t key = rng.below(1000) * 0x9e3779b97f4a7c15ULL;
+                    if (rng.below(2) == 0)
+                        tt.store(key, TTValue{static_cast<float>(key >> 40),
+                            static_cast<uint16_t>(key >> 20), 0, 0});
+                    else if (tt.probe(key, v) and
+                             (v.value != static_cast<float>(key >> 40) or
+                              v.depth != static_cast<uint16_t>(key >> 20)))
+                        ++wrong[t];
+                }
+            });
+        }
+    }
+    for (size_t t = 0; t != num_threads; ++t)
+        EXPECT_EQ(wrong[t], 0) << "Torn entries must never be returned.";
+}
+
+} // namespace exploding_kittens
\ No newline at end of file
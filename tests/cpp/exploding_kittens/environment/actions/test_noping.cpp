@@ -5,6 +5,11 @@
 #include "exploding_kittens/environment/actions/nope_utils.h"
 #include "exploding_kittens/environment/actions/play_nope.h"
 #include "exploding_kittens/environment/actions/skip_nope.h"
+#include "exploding_kittens/environment/rules.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
 
 namespace exploding_kittens {
 
@@ -17,14 +22,14 @@ class DummyNopable: public NopeableBase {
             NopeableBase(ActionEnum::Play_Shuffle, gs)
         {}
 
-        void append_legal_actions(std::vector<Action> &vec) const override {
+    protected:
+        void do_append_legal_actions(ActionList &list) const override {
             if (not gs.primary_hand().has(CardIdx::Shuffle))
                 return;
-            vec.emplace_back(ActionEnum::Play_Shuffle, std::array<uint8_t, UNIQUE_CARDS>{}, 0, 0);
-            vec.back().cards.at(to_uint(CardIdx::Shuffle)) = 1;
+            list.emplace_back(ActionEnum::Play_Shuffle, std::array<uint8_t, UNIQUE_CARDS>{}, 0, 0);
+            list.back().cards.at(to_uint(CardIdx::Shuffle)) = 1;
         }
 
-    protected:
         void enforce_action(Action const &a) override {
             ++call_count;
         }
@@ -312,4 +317,98 @@ TEST(NopingTest, SkipNopeSkipTest) {
         << "First player skipped, so should still have its nope.";
 }
 
+TEST(NopingTest, RestoreIntoNopeState) {
+    GameState gs;
+    DummyNopable dn(gs);
+    SkipNope sn(gs);
+    custom_state_reset(gs, 2, [](Cards &c) {
+        c.hands[0].counts()[to_uint(CardIdx::Shuffle)] = 1U;
+        c.hands[1].counts()[to_uint(CardIdx::Nope)] = 1U;
+    });
+    dn.take_action(get_legal_actions(dn).at(0));
+    ASSERT_EQ(gs.state, State::Nope);
+
+    GameStateSnapshot snap;
+    gs.save(snap);
+    sn.take_action(get_legal_actions(sn).at(0));
+    ASSERT_EQ(dn.call_count, 1) << "Skipping the nope enforces the action.";
+
+    gs.restore(snap);
+    EXPECT_EQ(gs.state, State::Nope) << "Should be back in the nope state.";
+    ASSERT_EQ(gs.secondary_players.size(), 1);
+    sn.take_action(get_legal_actions(sn).at(0));
+    EXPECT_EQ(dn.call_count, 2)
+        << "The staged action type should find the registered NopeableBase.";
+}
+
+TEST(NopingTest, UndoNopeActions) {
+    GameState gs;
+    DummyNopable dn(gs);
+    custom_state_reset(gs, 3, [](Cards &c) {
+        c.hands[0].counts()[to_uint(CardIdx::Shuffle)] = 1U;
+        c.hands[1].counts()[to_uint(CardIdx::Nope)] = 1U;
+        c.hands[2].counts()[to_uint(CardIdx::Nope)] = 1U;
+    });
+    dn.take_action(get_legal_actions(dn).at(0));
+    ASSERT_EQ(gs.state, State::Nope);
+    ASSERT_EQ(gs.secondary_players.size(), 2);
+
+    uint64_t hash = gs.hash();
+    uint8_t noper = gs.secondary_players.back();
+    UndoRecord undo = Rules::make_action(gs,
+        Action{ActionEnum::Play_Nope, {}, 0, 0});
+    EXPECT_TRUE(gs.is_noped);
+    EXPECT_EQ(gs.cards.hands[noper].has(CardIdx::Nope), 0);
+    Rules::undo_action(gs, undo);
+    EXPECT_EQ(gs.hash(), hash);
+    EXPECT_FALSE(gs.is_noped);
+    EXPECT_EQ(gs.cards.hands[noper].has(CardIdx::Nope), 1);
+    EXPECT_EQ(gs.cards.discard_pile.has(CardIdx::Nope), 0);
+    ASSERT_EQ(gs.secondary_players.size(), 2);
+    EXPECT_EQ(gs.secondary_players.back(), noper);
+
+    undo = Rules::make_action(gs, Action{ActionEnum::Skip_Nope, {}, 0, 0});
+    ASSERT_EQ(gs.secondary_players.size(), 1);
+    EXPECT_THROW(Rules::make_action(gs,
+        Action{ActionEnum::Skip_Nope, {}, 0, 0}), std::invalid_argument)
+        << "Skipping would carry out the staged action: can't be undone.";
+    EXPECT_EQ(dn.call_count, 0) << "Nothing should have happened.";
+    Rules::undo_action(gs, undo);
+    EXPECT_EQ(gs.hash(), hash);
+    EXPECT_EQ(gs.secondary_players.size(), 2);
+}
+
+TEST(NopingTest, NopeOrderAsChanceEvent) {
+    GameState gs;
+    DummyNopable dn(gs);
+    custom_state_reset(gs, 4, [](Cards &c) {
+        c.hands[0].counts()[to_uint(CardIdx::Shuffle)] = 1U;
+        for (uint8_t p = 1; p != 4; ++p)
+            c.hands[p].counts()[to_uint(CardIdx::Nope)] = 2U;
+    });
+    dn.take_action(get_legal_actions(dn).at(0));
+    ASSERT_EQ(gs.state, State::Nope);
+
+    Action nope{ActionEnum::Play_Nope, {}, 0, 0};
+    ChanceEvent event;
+    Rules::chance_event(gs, nope, event);
+    ASSERT_EQ(event.kind, ChanceKind::Nope_Order);
+    ASSERT_EQ(event.size, 6) << "Three players can nope again: 3! orders.";
+
+    uint64_t hash = gs.hash();
+    std::vector<std::vector<uint8_t>> orders;
+    for (ChanceOutcome const &outcome : event) {
+        EXPECT_DOUBLE_EQ(outcome.probability, 1.0 / 6);
+        UndoRecord undo = Rules::make_action(gs, nope, outcome);
+        orders.push_back(gs.secondary_players);
+        Rules::undo_action(gs, undo);
+        EXPECT_EQ(gs.hash(), hash);
+    }
+    EXPECT_EQ(orders.front(), (std::vector<uint8_t>{1, 2, 3}));
+    EXPECT_EQ(orders.back(), (std::vector<uint8_t>{3, 2, 1}));
+    std::sort(orders.begin(), orders.end());
+    EXPECT_EQ(std::unique(orders.begin(), orders.end()), orders.end())
+        << "Every outcome should be another order.";
+}
+
 } // exploding_kittens
\ No newline at end of file
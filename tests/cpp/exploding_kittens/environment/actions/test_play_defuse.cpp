@@ -4,10 +4,8 @@
 #include "exploding_kittens/environment/game_state.h"
 #include "exploding_kittens/environment/actions/play_defuse.h"
 #include "exploding_kittens/environment/actions/draw_card.h"
-#include "utils.h"
 
 #include <cstdint>
-#include <random>
 
 namespace exploding_kittens {
 
@@ -173,9 +171,7 @@ TEST(DefuseActionTest, SimpleGameTest) {
                 player_idx = g.primary_player;
 
                 actions = get_legal_actions(pd);
-                a = actions.at(
-                    std::uniform_int_distribution<size_t>(
-                        0, actions.size() - 1)(tabletop_general::randnum_gen));
+                a = actions.at(g.rng.below(actions.size()));
                 
                 ASSERT_EQ(g.primary_hand().has(CardIdx::Exploding_Kitten), 1)
                     << "We can only get here if we have a kitten, ofc.";
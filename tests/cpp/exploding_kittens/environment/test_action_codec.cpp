@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include "testing_utils.h"
+
+#include "exploding_kittens/environment/action_codec.h"
+#include "exploding_kittens/environment/vector_game_state.h"
+
+#include <stdexcept>
+#include <vector>
+
+namespace exploding_kittens {
+
+TEST(ActionCodecTests, AllCodesRoundTrip) {
+    for (size_t code = 0; code != NUM_ACTION_CODES; ++code) {
+        Action const &a = decode_action(code);
+        ASSERT_EQ(encode_action(a), code) << "Code " << code << " mismatch.";
+    }
+    EXPECT_EQ(decode_action(0).type, ActionEnum::Draw);
+    EXPECT_EQ(decode_action(NUM_ACTION_CODES - 1).type,
+        ActionEnum::Play_Three_Card_Combo);
+    EXPECT_THROW(decode_action(NUM_ACTION_CODES), std::out_of_range);
+}
+
+TEST(ActionCodecTests, InvalidActionsThrow) {
+    Action a{ActionEnum::Play_Defuse, {}, MAX_CARDS + 1, 0};
+    EXPECT_THROW(encode_action(a), std::invalid_argument)
+        << "Depth out of range has no code.";
+
+    a = Action{ActionEnum::Play_Two_Card_Combo, {}, 0, 0};
+    a.cards[to_uint(CardIdx::Cat_1)] = 1U;
+    a.cards[to_uint(CardIdx::Cat_2)] = 1U;
+    EXPECT_THROW(encode_action(a), std::invalid_argument)
+        << "A combo needs equal cards.";
+
+    a.type = ActionEnum::Total;
+    EXPECT_THROW(encode_action(a), std::invalid_argument);
+}
+
+TEST(ActionCodecTests, GeneratedActionsAreCanonical) {
+    VectorGameState vgs(16, 3, 7);
+    ActionList legal;
+    std::vector<ActionCode> codes(vgs.size());
+    std::vector<uint8_t> masks(vgs.size() * NUM_ACTION_CODES);
+
+    size_t max_steps = 1000;
+    while (not vgs.all_done()) {
+        vgs.legal_action_masks(masks);
+        for (size_t idx = 0; idx != vgs.size(); ++idx) {
+            legal.clear();
+            vgs.append_legal_actions(idx, legal);
+
+            size_t mask_sum = 0;
+            for (size_t c = 0; c != NUM_ACTION_CODES; ++c)
+                mask_sum += masks[idx * NUM_ACTION_CODES + c];
+            ASSERT_EQ(mask_sum, legal.size()) << "All legal codes are unique.";
+
+            for (Action const &a : legal) {
+                ActionCode code = encode_action(a);
+                ASSERT_EQ(decode_action(code), a)
+                    << "Decoding should give back the generated action.";
+                ASSERT_EQ(masks[idx * NUM_ACTION_CODES + code], 1U);
+            }
+            if (not legal.empty())
+                codes[idx] = encode_action(legal.back());
+        }
+        vgs.step(codes);
+        ASSERT_NE(--max_steps, 0) << "Games should not take this long.";
+    }
+}
+
+} // namespace exploding_kittens
\ No newline at end of file
@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+#include "testing_utils.h"
+
+#include "exploding_kittens/environment/action_list.h"
+#include "exploding_kittens/environment/actions/play_defuse.h"
+
+#include <vector>
+
+namespace exploding_kittens {
+
+TEST(ActionListTests, BasicInterface) {
+    ActionList list;
+    EXPECT_TRUE(list.empty());
+
+    list.emplace_back(ActionEnum::Play_Defuse,
+        std::array<uint8_t, UNIQUE_CARDS>{}, 3, 0);
+    list.push_back(Action{ActionEnum::Draw, {}, 0, 0});
+    ASSERT_EQ(list.size(), 2);
+    EXPECT_EQ(list[0].arg1, 3);
+    EXPECT_EQ(list.back().type, ActionEnum::Draw);
+    EXPECT_EQ(list.end() - list.begin(), 2);
+
+    list.clear();
+    EXPECT_TRUE(list.empty()) << "Clearing should only reset the size.";
+}
+
+TEST(ActionListTests, SameActionsAsVectorOverload) {
+    GameState g;
+    PlayDefuse pd(g);
+
+    // Largest possible deck, with a kitten to put back:
+    defuse_state_reset(g, 2, [](Cards &c) {
+        c.deck.counts()[to_uint(CardIdx::Cat_1)] = MAX_CARDS - 2;
+    });
+
+    ActionList list;
+    pd.append_legal_actions(list);
+    std::vector<Action> vec = get_legal_actions(pd);
+
+    ASSERT_EQ(list.size(), MAX_CARDS - 1) << "One depth more than cards.";
+    ASSERT_EQ(list.size(), vec.size());
+    for (size_t idx = 0; idx != vec.size(); ++idx)
+        EXPECT_EQ(list[idx], vec[idx]);
+}
+
+} // namespace exploding_kittens
\ No newline at end of file
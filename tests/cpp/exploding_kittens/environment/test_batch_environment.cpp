@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+
+#include "exploding_kittens/environment/batch_environment.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace exploding_kittens {
+
+// Buffers for a BatchEnvironment, as a Python user would preallocate them.
+struct Buffers {
+    std::vector<float> observations;
+    std::vector<float> rewards;
+    std::vector<uint8_t> dones;
+    std::vector<uint8_t> agents;
+    std::vector<uint8_t> masks;
+
+    Buffers(size_t num_games, size_t num_players)
+    :
+        observations(num_games * OBS_SIZE),
+        rewards(num_games * num_players),
+        dones(num_games),
+        agents(num_games),
+        masks(num_games * NUM_ACTION_CODES)
+    {}
+
+    BatchOutputs outputs() {
+        return BatchOutputs{observations, rewards, dones, agents, masks};
+    }
+};
+
+TEST(BatchEnvironmentTests, PlaysGamesToTheEnd) {
+    BatchEnvironment env(8, 3, 11);
+    Buffers buf(env.size(), env.num_players());
+    env.reset(buf.outputs());
+
+    tabletop_general::Rng rng(12);
+    std::vector<ActionCode> actions(env.size());
+    std::vector<float> total_rewards(env.size() * env.num_players());
+    for (size_t step = 0; step != 10000; ++step) {
+        for (size_t idx = 0; idx != env.size(); ++idx) {
+            EXPECT_EQ(buf.dones[idx],
+                env.games().states()[idx] == State::Game_Over);
+            EXPECT_EQ(buf.agents[idx], env.games()[idx].acting_player());
+
+            // A random legal action, from the mask:
+            std::vector<ActionCode> legal;
+            for (size_t code = 0; code != NUM_ACTION_CODES; ++code)
+                if (buf.masks[idx * NUM_ACTION_CODES + code])
+                    legal.push_back(code);
+            ASSERT_EQ(legal.empty(), buf.dones[idx] == 1)
+                << "Only finished games have no legal actions.";
+            actions[idx] = legal.empty() ? 0 : legal[rng.below(legal.size())];
+        }
+        env.step(actions, buf.outputs());
+        for (size_t k = 0; k != total_rewards.size(); ++k)
+            total_rewards[k] += buf.rewards[k];
+        if (env.games().all_done())
+            break;
+    }
+    ASSERT_TRUE(env.games().all_done());
+
+    // Every game paid out exactly once: one winner and two losers.
+    for (size_t idx = 0; idx != env.size(); ++idx) {
+        float sum = 0;
+        for (size_t player = 0; player != env.num_players(); ++player)
+            sum += total_rewards[idx * env.num_players() + player];
+        EXPECT_EQ(sum, -1.0f);
+        EXPECT_EQ(total_rewards[idx * env.num_players() +
+            env.games()[idx].winner()], 1.0f);
+    }
+}
+
+TEST(BatchEnvironmentTests, AutoReset) {
+    BatchEnvironment env(4, 2, 13, true);
+    Buffers buf(env.size(), env.num_players());
+    env.reset(buf.outputs());
+
+    tabletop_general::Rng rng(14);
+    std::vector<ActionCode> actions(env.size());
+    size_t finished = 0;
+    for (size_t step = 0; step != 2000; ++step) {
+        for (size_t idx = 0; idx != env.size(); ++idx) {
+            std::vector<ActionCode> legal;
+            for (size_t code = 0; code != NUM_ACTION_CODES; ++code)
+                if (buf.masks[idx * NUM_ACTION_CODES + code])
+                    legal.push_back(code);
+            ASSERT_FALSE(legal.empty()) << "Games never stay finished.";
+            actions[idx] = legal[rng.below(legal.size())];
+        }
+        env.step(actions, buf.outputs());
+
+        for (size_t idx = 0; idx != env.size(); ++idx) {
+            if (not buf.dones[idx])
+                continue;
+            ++finished;
+            EXPECT_EQ(buf.rewards[idx * 2] + buf.rewards[idx * 2 + 1], 0.0f)
+                << "One winner and one loser.";
+            EXPECT_EQ(env.games()[idx].state, State::Default)
+                << "Already reset to a new game.";
+            EXPECT_EQ(buf.observations[idx * OBS_SIZE + OBS_HAND_SIZES],
+                CARDS_2_DEAL + 1) << "The observation is of the new game.";
+        }
+    }
+    EXPECT_GT(finished, env.size()) << "Games should be played repeatedly.";
+}
+
+TEST(BatchEnvironmentTests, ChecksBufferSizes) {
+    BatchEnvironment env(2, 2);
+    Buffers buf(env.size(), env.num_players());
+    buf.rewards.pop_back();
+    EXPECT_THROW(env.reset(buf.outputs()), std::invalid_argument);
+
+    Buffers good(env.size(), env.num_players());
+    std::vector<ActionCode> actions(3);
+    EXPECT_THROW(env.step(actions, good.outputs()), std::invalid_argument);
+}
+
+TEST(BatchEnvironmentTests, RejectsIllegalActions) {
+    BatchEnvironment env(3, 2, 5);
+    Buffers buf(env.size(), env.num_players());
+    env.reset(buf.outputs());
+
+    // Legal actions everywhere, except an illegal one for game 2:
+    std::vector<ActionCode> actions(env.size());
+    for (size_t idx = 0; idx != env.size(); ++idx) {
+        uint8_t const *mask = &buf.masks[idx * NUM_ACTION_CODES];
+        uint8_t wanted = idx == 2 ? 0 : 1;
+        actions[idx] = std::find(mask, mask + NUM_ACTION_CODES, wanted) -
+                       mask;
+    }
+    EXPECT_EQ(decode_action(actions[2]).type, ActionEnum::Play_Defuse)
+        << "There is no kitten to defuse.";
+
+    std::vector<uint64_t> hashes;
+    for (size_t idx = 0; idx != env.size(); ++idx)
+        hashes.push_back(env.games()[idx].hash());
+    EXPECT_THROW(env.step(actions, buf.outputs()), std::invalid_argument);
+    for (size_t idx = 0; idx != env.size(); ++idx)
+        EXPECT_EQ(env.games()[idx].hash(), hashes[idx])
+            << "No game is stepped.";
+
+    actions[2] = actions[0];
+    EXPECT_NO_THROW(env.step(actions, buf.outputs()));
+}
+
+} // namespace exploding_kittens
\ No newline at end of file
@@ -4,14 +4,17 @@
 #include "exploding_kittens/environment/cards.h"
 
 #include <random>
+#include <stdexcept>
+#include <vector>
 
 namespace exploding_kittens {
 
 
 TEST(CardsTests, InitChecks) {
     Cards cards;
+    tabletop_general::Rng rng;
     for (size_t num_players = MIN_PLAYERS; num_players <= MAX_PLAYERS; ++num_players) {
-        cards.reset(num_players);
+        cards.reset(num_players, rng);
 
         EXPECT_TRUE(cards_integrity_check(cards));
 
@@ -42,16 +45,17 @@ TEST(CardsTests, InitChecks) {
         }
 
         // Check if it throws when we give an invalid number of players:
-        EXPECT_THROW(cards.reset(1), std::invalid_argument)
+        EXPECT_THROW(cards.reset(1, rng), std::invalid_argument)
             << "reset() should throw when specifying too few players.";
-        EXPECT_THROW(cards.reset(6), std::invalid_argument)
+        EXPECT_THROW(cards.reset(6, rng), std::invalid_argument)
             << "reset() should throw when given too many players.";
     }
 }
 
 TEST(CardsTests, StackPopAndTop) {
     Cards cards;
-    cards.reset(5);
+    tabletop_general::Rng rng;
+    cards.reset(5, rng);
 
     size_t total = col_sum(cards.deck);
     EXPECT_EQ(cards.deck.get_top_n(1000).size(), total)
@@ -76,6 +80,7 @@ TEST(CardsTests, StackPopAndTop) {
 
 TEST(CardsTests, StackPush) {
     Cards cards;
+    tabletop_general::Rng rng;
     auto test_push = [&](CardIdx i) {
         uint8_t before = cards.deck.has(i);
         cards.deck.push(i);
@@ -86,17 +91,18 @@ TEST(CardsTests, StackPush) {
 
     std::uniform_int_distribution<uint8_t> dist(0, UNIQUE_CARDS - 1);
     for (size_t num_players = MIN_PLAYERS; num_players <= MAX_PLAYERS; ++num_players) {
-        cards.reset(num_players);
+        cards.reset(num_players, rng);
         
         // Doing 3 pushes each time:
-        test_push(static_cast<CardIdx>(dist(tabletop_general::randnum_gen)));
-        test_push(static_cast<CardIdx>(dist(tabletop_general::randnum_gen)));
-        test_push(static_cast<CardIdx>(dist(tabletop_general::randnum_gen)));
+        test_push(static_cast<CardIdx>(dist(rng)));
+        test_push(static_cast<CardIdx>(dist(rng)));
+        test_push(static_cast<CardIdx>(dist(rng)));
     }
 }
 
 TEST(CardsTests, StackInsert) {
     Cards cards;
+    tabletop_general::Rng rng;
     auto test_insert = [&](CardIdx i, size_t depth) {
         uint8_t before = cards.deck.has(i);
         cards.deck.insert(i, depth);
@@ -109,14 +115,40 @@ TEST(CardsTests, StackInsert) {
     std::uniform_int_distribution<uint8_t> dist(0, UNIQUE_CARDS - 1);
     for (size_t num_players = MIN_PLAYERS; num_players <= MAX_PLAYERS; ++num_players) {
         for (size_t depth = 0; depth != 40; ++depth) {
-            cards.reset(num_players);
-            test_insert(static_cast<CardIdx>(dist(tabletop_general::randnum_gen)), depth);
+            cards.reset(num_players, rng);
+            test_insert(static_cast<CardIdx>(dist(rng)), depth);
         }
     }
 }
 
+TEST(CardsTests, StackInsertKeepsOrder) {
+    Cards cards;
+    tabletop_general::Rng rng(8);
+    cards.reset(MAX_PLAYERS, rng);
+
+    // Filling the deck up to its capacity, comparing against a vector model:
+    auto top = cards.deck.get_top_n(MAX_CARDS);
+    std::vector<CardIdx> model(top.begin(), top.end());
+    while (cards.deck.size() != MAX_CARDS) {
+        CardIdx i = from_uint(rng.below(UNIQUE_CARDS));
+        size_t depth = rng.below(cards.deck.size() + 2);
+        cards.deck.insert(i, depth);
+        model.insert(depth > model.size() ? model.begin() :
+            model.end() - depth, i);
+    }
+    top = cards.deck.get_top_n(MAX_CARDS);
+    EXPECT_TRUE(std::vector<CardIdx>(top.begin(), top.end()) == model)
+        << "Inserting should shift exactly the cards above the new one.";
+    EXPECT_EQ(cards.deck.order_hash(), cards.deck.compute_order_hash());
+
+    cards.deck.counts()[to_uint(CardIdx::Cat_1)] = MAX_CARDS;
+    EXPECT_THROW(cards.deck.ordered_from_data(), std::length_error)
+        << "A stack can not hold more than MAX_CARDS cards.";
+}
+
 TEST(CardsTests, HandTakeFromStack) {
     Cards cards;
+    tabletop_general::Rng rng;
     auto test_take = [&](size_t hand_idx) {
         auto hand_prev = copy_counts(cards.hands[hand_idx]);
         auto deck_prev = copy_counts(cards.deck);
@@ -139,7 +171,7 @@ TEST(CardsTests, HandTakeFromStack) {
     };
 
     for (size_t num_players = MIN_PLAYERS; num_players <= MAX_PLAYERS; ++num_players) {
-        cards.reset(num_players);
+        cards.reset(num_players, rng);
         for (size_t hand_idx = 0; hand_idx != num_players; ++hand_idx) {
             test_take(hand_idx);
         }
@@ -151,10 +183,11 @@ TEST(CardsTests, HandTakeFromStack) {
 
 TEST(CardsTests, HandTakeFromOther) {
     Cards cards;
+    tabletop_general::Rng rng;
     auto test_take = [&](size_t hand_idx, size_t other_idx) {
         auto hand_prev = copy_counts(cards.hands[hand_idx]);
         auto other_prev = copy_counts(cards.hands[other_idx]);
-        CardIdx card = cards.hands[hand_idx].take_from(cards.hands[other_idx]);
+        CardIdx card = cards.hands[hand_idx].take_from(cards.hands[other_idx], rng);
         for (uint8_t i = 0; i != UNIQUE_CARDS; ++i) {
             if (i == static_cast<uint8_t>(card) and hand_idx != other_idx) {
                 EXPECT_EQ(cards.hands[hand_idx].has(i), hand_prev[i] + 1)
@@ -174,7 +207,7 @@ TEST(CardsTests, HandTakeFromOther) {
 
     // Always next one:
     for (size_t num_players = MIN_PLAYERS; num_players <= MAX_PLAYERS; ++num_players) {
-        cards.reset(num_players);
+        cards.reset(num_players, rng);
         for (size_t hand_idx = 0; hand_idx != num_players; ++hand_idx) {
             test_take(hand_idx, (hand_idx + 1) % num_players);
         }
@@ -182,18 +215,18 @@ TEST(CardsTests, HandTakeFromOther) {
 
     // Always pick from player zero:
     for (size_t num_players = MIN_PLAYERS; num_players <= MAX_PLAYERS; ++num_players) {
-        cards.reset(num_players);
+        cards.reset(num_players, rng);
         for (size_t hand_idx = 0; hand_idx != num_players; ++hand_idx) {
             test_take(hand_idx, 0);
         }
     }
 
     // Pick from player zero till empty:
-    cards.reset(2);
+    cards.reset(2, rng);
     for (size_t i = 0; i != (CARDS_2_DEAL + 1); ++i) {
         test_take(1, 0);
     }
-    EXPECT_EQ(cards.hands[1].take_from(cards.hands[0]), CardIdx::Error)
+    EXPECT_EQ(cards.hands[1].take_from(cards.hands[0], rng), CardIdx::Error)
         << "Taking more cards than player has should return error card.";
     
     test_take(1, 0); // should still pass because for card == i never true, so
@@ -202,7 +235,8 @@ TEST(CardsTests, HandTakeFromOther) {
 
 TEST(CardsTests, HandTakeKnownFromOther) {
     Cards cards;
-    cards.reset(5);
+    tabletop_general::Rng rng;
+    cards.reset(5, rng);
     for (size_t i = 0; i != 5; ++i) {
         EXPECT_EQ(cards.hands[0].take_from(cards.hands[i], CardIdx::Defuse),
             CardIdx::Defuse) << "Should be able to take defuse from all, also self.";
@@ -222,7 +256,8 @@ TEST(CardsTests, HandTakeKnownFromOther) {
 
 TEST(CardsTests, HandPlaceAtTop) {
     Cards cards;
-    cards.reset(2);
+    tabletop_general::Rng rng;
+    cards.reset(2, rng);
 
     EXPECT_THROW(cards.hands[0].place_at(
         cards.discard_pile, CardIdx::Exploding_Kitten), std::range_error)
@@ -241,9 +276,10 @@ TEST(CardsTests, HandPlaceAtTop) {
 
 TEST(CardsTests, HandPlaceInside) {
     Cards cards;
+    tabletop_general::Rng rng;
     
-    tabletop_general::randnum_gen.seed(1996);
-    cards.reset(2);
+    rng.seed(1996);
+    cards.reset(2, rng);
     EXPECT_THROW(cards.hands[0].place_at(
         cards.deck, CardIdx::Exploding_Kitten, 5), std::range_error)
         << "Placing a card that is not there should throw.";
@@ -261,8 +297,8 @@ TEST(CardsTests, HandPlaceInside) {
     std::vector<CardIdx> insert_order_copy{insert_order.begin(), 
         insert_order.end()};
 
-    tabletop_general::randnum_gen.seed(1996);
-    cards.reset(2);
+    rng.seed(1996);
+    cards.reset(2, rng);
     cards.hands[0].place_at(cards.deck, CardIdx::Defuse);
     auto push_hand = copy_counts(cards.hands[0]);
     auto push_order = cards.deck.get_top_n(1000);
@@ -274,7 +310,7 @@ TEST(CardsTests, HandPlaceInside) {
         << "Inserting on top should be identical to pushing.";
     
     for (size_t depth = 0; depth != 50; ++depth) {
-        cards.reset(2);
+        cards.reset(2, rng);
         cards.hands[0].place_at(cards.deck, CardIdx::Defuse, depth);
         EXPECT_EQ(cards.deck.get_top_n(depth + 1)[0], CardIdx::Defuse)
             << "Specified card should be at given location. If depth is larger "
@@ -286,7 +322,8 @@ TEST(CardsTests, HandPlaceInside) {
 
 TEST(CardsTests, HandGiveTo) {
     Cards cards;
-    cards.reset(2);
+    tabletop_general::Rng rng;
+    cards.reset(2, rng);
 
     ASSERT_THROW(cards.hands[0].give_to(
         cards.hands[1], CardIdx::Exploding_Kitten), std::range_error)
@@ -315,4 +352,59 @@ TEST(CardsTests, HandGiveTo) {
     ASSERT_TRUE(cards_integrity_check(cards));
 }
 
+TEST(CardsTests, LazyStackResolvesFromRemainingCards) {
+    Cards cards;
+    tabletop_general::Rng rng(3);
+    cards.deck.set_lazy(true);
+    cards.reset(3, rng);
+
+    CardStack &deck = cards.deck;
+    size_t total = deck.size();
+    for (size_t depth = 0; depth != total; ++depth)
+        ASSERT_EQ(deck.peek(depth), CardIdx::Unresolved)
+            << "A fresh lazy deck has no order yet.";
+    EXPECT_EQ(deck.order_hash(), deck.compute_order_hash());
+
+    // Unresolved cards can't be taken, and nothing changes trying:
+    size_t hand_size = cards.hands[0].total();
+    EXPECT_THROW(cards.hands[0].take_from(deck), std::logic_error);
+    EXPECT_THROW(deck.remove(1), std::logic_error);
+    EXPECT_EQ(deck.size(), total);
+    EXPECT_EQ(cards.hands[0].total(), hand_size);
+
+    deck.resolve_top(3, rng);
+    EXPECT_EQ(deck.order_hash(), deck.compute_order_hash());
+    EXPECT_NE(deck.peek(2), CardIdx::Unresolved);
+    EXPECT_EQ(deck.peek(3), CardIdx::Unresolved) << "Only the top 3.";
+    EXPECT_THROW(deck.set_lazy(false), std::logic_error)
+        << "Can't leave lazy mode with unresolved positions.";
+
+    // Resolving everything gives back exactly the cards in the deck:
+    deck.resolve_top(1000, rng);
+    EXPECT_EQ(deck.order_hash(), deck.compute_order_hash());
+    auto counts = to_counts(deck);
+    for (uint8_t i = 0; i != UNIQUE_CARDS; ++i)
+        EXPECT_EQ(counts[i], deck.has(i));
+    EXPECT_TRUE(cards_integrity_check(cards));
+    EXPECT_NO_THROW(deck.set_lazy(false));
+}
+
+TEST(CardsTests, LazyStackTopIsUniform) {
+    CardStack stack;
+    stack.counts()[to_uint(CardIdx::Defuse)] = 1;
+    stack.counts()[to_uint(CardIdx::Skip)] = 3;
+    stack.set_lazy(true);
+    stack.ordered_from_data();
+
+    tabletop_general::Rng rng(11);
+    size_t skips = 0;
+    for (size_t it = 0; it != 4000; ++it) {
+        stack.shuffle(rng);
+        stack.resolve_top(1, rng);
+        skips += stack.peek(0) == CardIdx::Skip;
+    }
+    EXPECT_NEAR(skips, 3000, 150)
+        << "The top card is drawn proportionally to the counts.";
+}
+
 } // namespace exploding_kittens
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include "testing_utils.h"
+
+#include "exploding_kittens/environment/rules.h"
+
+namespace exploding_kittens {
+
+TEST(ChanceTests, DrawOutcomesFollowTheCounts) {
+    GameState g;
+    g.seed(4);
+    g.cards.deck.set_lazy(true);
+    g.reset(3);
+    Action draw{ActionEnum::Draw, {}, 0, 0};
+
+    ChanceEvent event;
+    Rules::chance_event(g, draw, event);
+    ASSERT_EQ(event.kind, ChanceKind::Draw);
+    double total = 0.0;
+    for (ChanceOutcome const &outcome : event) {
+        EXPECT_DOUBLE_EQ(outcome.probability,
+            static_cast<double>(g.cards.deck.has(outcome.value)) /
+            g.cards.deck.size());
+        total += outcome.probability;
+    }
+    EXPECT_DOUBLE_EQ(total, 1.0);
+
+    // Every outcome can be stepped into, and undone:
+    uint64_t hash = g.hash();
+    for (ChanceOutcome const &outcome : event) {
+        uint8_t before = g.primary_hand().has(outcome.value);
+        UndoRecord undo = Rules::make_action(g, draw, outcome);
+        EXPECT_EQ(g.cards.hands[undo.primary_player].has(outcome.value),
+                  before + 1) << "The chosen card should have been drawn.";
+        ASSERT_EQ(g.hash(), g.full_hash());
+        Rules::undo_action(g, undo);
+        EXPECT_EQ(g.hash(), hash);
+    }
+
+    uint8_t card = event.outcomes[0].value;
+    uint8_t before = g.cards.hands[0].has(card);
+    Rules::take_action(g, draw, event.outcomes[0]);
+    EXPECT_EQ(g.cards.hands[0].has(card), before + 1);
+    ASSERT_EQ(g.hash(), g.full_hash());
+}
+
+TEST(ChanceTests, ResolvedDrawsAreNoChance) {
+    GameState g;
+    g.seed(4);
+    g.reset(2);
+    ChanceEvent event;
+    Rules::chance_event(g, Action{ActionEnum::Draw, {}, 0, 0}, event);
+    EXPECT_EQ(event.kind, ChanceKind::None) << "A shuffled deck is fixed.";
+    ASSERT_EQ(event.size, 1);
+    EXPECT_EQ(event.outcomes[0].probability, 1.0);
+}
+
+TEST(ChanceTests, ForgetUnknownKeepsKnownPositions) {
+    GameState g;
+    defuse_state_reset(g, 2, [](Cards &c) {
+        c.deck.counts()[to_uint(CardIdx::Skip)] = 3U;
+    });
+    Rules::take_action(g, Action{ActionEnum::Play_Defuse, {}, 1, 0});
+
+    CardStack &deck = g.cards.deck;
+    deck.forget_unknown();
+    EXPECT_TRUE(deck.is_lazy());
+    EXPECT_EQ(deck.peek(0), CardIdx::Unresolved);
+    EXPECT_EQ(deck.peek(1), CardIdx::Exploding_Kitten) << "Player 0 knows.";
+    EXPECT_EQ(deck.unresolved_counts()[to_uint(CardIdx::Skip)], 3);
+    EXPECT_EQ(deck.unresolved_counts()[to_uint(CardIdx::Exploding_Kitten)], 0);
+    EXPECT_EQ(g.hash(), g.full_hash());
+
+    // Player 1 draws a Skip for sure, then player 0 the kitten:
+    ChanceEvent event;
+    Rules::chance_event(g, Action{ActionEnum::Draw, {}, 0, 0}, event);
+    ASSERT_EQ(event.size, 1);
+    EXPECT_EQ(event.outcomes[0].value, to_uint(CardIdx::Skip));
+    EXPECT_EQ(event.outcomes[0].probability, 1.0);
+}
+
+} // namespace exploding_kittens
\ No newline at end of file
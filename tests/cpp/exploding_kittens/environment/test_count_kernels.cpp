@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include "testing_utils.h"
+
+#include "exploding_kittens/environment/count_kernels.h"
+#include "exploding_kittens/environment/vector_game_state.h"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace exploding_kittens {
+
+using Counts = std::array<uint8_t, COUNTS_WIDTH>;
+
+static Counts random_counts(tabletop_general::Rng &rng) {
+    Counts counts{};
+    for (size_t i = 0; i != UNIQUE_CARDS; ++i)
+        counts[i] = rng.below(2) == 0 ? 0 : rng.below(5);
+    return counts;
+}
+
+TEST(CountKernelsTests, MatchScalarReference) {
+    tabletop_general::Rng rng(21);
+    for (size_t it = 0; it != 1000; ++it) {
+        Counts counts = random_counts(rng);
+
+        uint32_t total = 0;
+        uint16_t mask = 0;
+        for (size_t i = 0; i != UNIQUE_CARDS; ++i) {
+            total += counts[i];
+            mask |= (counts[i] != 0) << i;
+        }
+        ASSERT_EQ(count_total(counts.data()), total);
+        ASSERT_EQ(count_nonzero_mask(counts.data()), mask);
+
+        // Every r maps to the card that owns it:
+        uint32_t r = 0;
+        for (uint8_t i = 0; i != UNIQUE_CARDS; ++i)
+            for (uint8_t n = 0; n != counts[i]; ++n, ++r)
+                ASSERT_EQ(count_sample(counts.data(), r), i);
+    }
+}
+
+TEST(CountKernelsTests, BatchKernels) {
+    tabletop_general::Rng rng(22);
+    std::vector<Counts> all(11);    // Not a multiple of the vector width.
+    for (Counts &c : all)
+        c = random_counts(rng);
+    all[3] = Counts{};              // One empty collection.
+
+    // Back to back:
+    std::span<uint8_t const> rows(all.front().data(),
+        all.size() * COUNTS_WIDTH);
+    std::vector<uint8_t> totals(all.size());
+    count_totals(rows, totals);
+    for (size_t idx = 0; idx != all.size(); ++idx)
+        EXPECT_EQ(totals[idx], count_total(all[idx].data()));
+
+    std::vector<CardIdx> samples(all.size());
+    count_samples(rows, rng, samples);
+    for (size_t idx = 0; idx != all.size(); ++idx) {
+        if (totals[idx] == 0)
+            EXPECT_EQ(samples[idx], CardIdx::Error);
+        else
+            EXPECT_NE(all[idx][to_uint(samples[idx])], 0)
+                << "Can only sample cards that are there.";
+    }
+
+    std::vector<uint8_t> wrong_size(3);
+    EXPECT_THROW(count_totals(rows, wrong_size), std::invalid_argument);
+}
+
+TEST(CountKernelsTests, VectorGameStateHandSizes) {
+    VectorGameState vgs(9, 3);
+    std::vector<uint8_t> sizes(vgs.size() * 3);
+    vgs.hand_sizes(sizes);
+    for (size_t idx = 0; idx != vgs.size(); ++idx)
+        for (size_t p = 0; p != 3; ++p)
+            EXPECT_EQ(sizes[idx * 3 + p], col_sum(vgs[idx].cards.hands[p]))
+                << "A new game deals 8 cards to every player.";
+
+    // The mirrored counts follow the games as they are stepped:
+    tabletop_general::Rng rng(23);
+    ActionList legal;
+    for (size_t step = 0; step != 20; ++step) {
+        for (size_t idx = 0; idx != vgs.size(); ++idx) {
+            legal.clear();
+            vgs.append_legal_actions(idx, legal);
+            if (not legal.empty())
+                vgs.step(idx, legal[rng.below(legal.size())]);
+        }
+    }
+    auto row = [](std::span<uint8_t const> rows, size_t r) {
+        return rows.subspan(r * COUNTS_WIDTH, COUNTS_WIDTH);
+    };
+    auto same = [](std::span<uint8_t const> mirror, CardCollection const &c) {
+        return std::equal(mirror.begin(), mirror.end(), c.counts());
+    };
+    for (size_t idx = 0; idx != vgs.size(); ++idx) {
+        Cards const &cards = vgs[idx].cards;
+        for (size_t p = 0; p != 3; ++p)
+            EXPECT_TRUE(same(row(vgs.hand_counts(), idx * 3 + p),
+                cards.hands[p]));
+        EXPECT_TRUE(same(row(vgs.deck_counts(), idx), cards.deck));
+        EXPECT_TRUE(same(row(vgs.discard_counts(), idx), cards.discard_pile));
+    }
+}
+
+} // namespace exploding_kittens
\ No newline at end of file
@@ -1,8 +1,11 @@
 #include <gtest/gtest.h>
 
 #include "exploding_kittens/environment/game_state.h"
+#include "exploding_kittens/environment/rules.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <vector>
 
 namespace exploding_kittens {
 
@@ -46,7 +49,7 @@ TEST(GameStateTests, RegisterTurnWithDeadPlayersTest) {
         hand.counts()[to_uint(CardIdx::Defuse)] = 0;
     g.cards.deck.counts()[to_uint(CardIdx::Defuse)] = 0;
     g.cards.deck.ordered_from_data();
-    g.cards.deck.shuffle();
+    g.cards.deck.shuffle(g.rng);
 
     while (g.is_alive(1))
         g.cards.hands[1].take_from(g.cards.deck);
@@ -93,4 +96,80 @@ TEST(GameStateTests, RegisterTurnWithDeadPlayersTest) {
         << "All exploding kittens should have been drawn.";
 }
 
+TEST(GameStateTests, SeedingIsDeterministic) {
+    GameState a, b;
+    a.seed(1234);
+    b.seed(1234);
+    for (size_t game = 0; game != 3; ++game) {
+        a.reset(4);
+        b.reset(4);
+        auto deck_a = a.cards.deck.get_top_n(1000);
+        auto deck_b = b.cards.deck.get_top_n(1000);
+        EXPECT_TRUE(std::vector<CardIdx>(deck_a.begin(), deck_a.end()) ==
+                    std::vector<CardIdx>(deck_b.begin(), deck_b.end()))
+            << "Same seed should give the same deck order every game.";
+        for (uint8_t p = 0; p != 4; ++p)
+            for (uint8_t i = 0; i != UNIQUE_CARDS; ++i)
+                EXPECT_EQ(a.cards.hands[p].has(i), b.cards.hands[p].has(i))
+                    << "Same seed should deal the same hands.";
+    }
+}
+
+TEST(GameStateTests, IncrementalHashMatchesFullHash) {
+    GameState g;
+    g.seed(42);
+    ActionList legal;
+    for (size_t game = 0; game != 20; ++game) {
+        g.reset(2 + game % 4);
+        ASSERT_EQ(g.hash(), g.full_hash()) << "Dealing should keep it in sync.";
+        while (g.state != State::Game_Over) {
+            legal.clear();
+            Rules::append_legal_actions(g, legal);
+            Rules::take_action(g, legal[g.rng.below(legal.size())]);
+            ASSERT_EQ(g.hash(), g.full_hash())
+                << "Every action should keep the incremental hash in sync.";
+        }
+    }
+}
+
+TEST(GameStateTests, HashOnlyDependsOnState) {
+    GameState g;
+    g.seed(7);
+    g.reset(3);
+    uint64_t start = g.hash();
+
+    // Moving a card around and back should give the same hash:
+    CardIdx top = g.primary_hand().take_from(g.cards.deck);
+    EXPECT_NE(g.hash(), start);
+    g.primary_hand().place_at(g.cards.deck, top, 5);
+    EXPECT_NE(g.hash(), start) << "The deck order differs now.";
+    g.cards.deck.insert(g.cards.deck.pop(), 0);   // No-op.
+    auto top_6 = g.cards.deck.get_top_n(6);
+    ASSERT_EQ(top_6[0], top);
+    std::rotate(top_6.begin(), top_6.begin() + 1, top_6.end());
+    g.cards.deck.rehash();
+    EXPECT_EQ(g.hash(), start) << "Same state, so same hash.";
+
+    g.primary_player = 1;
+    EXPECT_NE(g.hash(), start) << "Scalars are part of the hash too.";
+}
+
+TEST(GameStateTests, LazyDeckKeepsHashInSync) {
+    GameState g;
+    g.seed(43);
+    g.cards.deck.set_lazy(true);
+    ActionList legal;
+    for (size_t game = 0; game != 20; ++game) {
+        g.reset(2 + game % 4);
+        ASSERT_EQ(g.hash(), g.full_hash());
+        while (g.state != State::Game_Over) {
+            legal.clear();
+            Rules::append_legal_actions(g, legal);
+            Rules::take_action(g, legal[g.rng.below(legal.size())]);
+            ASSERT_EQ(g.hash(), g.full_hash())
+                << "Resolving cards should keep the hash in sync too.";
+        }
+    }
+}
+
 } // namespace exploding_kittens
\ No newline at end of file
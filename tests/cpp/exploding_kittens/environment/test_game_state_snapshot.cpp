@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include "testing_utils.h"
+
+#include "exploding_kittens/environment/game_state.h"
+#include "exploding_kittens/environment/rules.h"
+
+#include <cstring>
+#include <vector>
+
+namespace exploding_kittens {
+
+// Plays random legal actions until the game ends, returns the action count.
+static size_t play_out(GameState &g) {
+    ActionList legal;
+    size_t steps = 0;
+    while (g.state != State::Game_Over) {
+        legal.clear();
+        Rules::append_legal_actions(g, legal);
+        Rules::take_action(g, legal[g.rng.below(legal.size())]);
+        ++steps;
+    }
+    return steps;
+}
+
+TEST(GameStateSnapshotTests, RestoreGivesSameState) {
+    GameState g;
+    g.seed(99);
+    g.reset(4);
+    uint64_t hash_before = g.hash();
+
+    GameStateSnapshot snap;
+    g.save(snap);
+
+    play_out(g);
+    ASSERT_NE(g.hash(), hash_before) << "Playing should change the state.";
+
+    g.restore(snap);
+    EXPECT_EQ(g.hash(), hash_before) << "Restoring should undo everything.";
+    EXPECT_EQ(g.num_players(), 4);
+    EXPECT_EQ(g.state, State::Default);
+    EXPECT_TRUE(cards_integrity_check(g.cards));
+}
+
+TEST(GameStateSnapshotTests, RestoredGamesReplayIdentically) {
+    GameState g;
+    g.seed(5);
+    g.reset(3);
+
+    // Get somewhere in the middle of a game first:
+    ActionList legal;
+    for (size_t i = 0; i != 10 and g.state != State::Game_Over; ++i) {
+        legal.clear();
+        Rules::append_legal_actions(g, legal);
+        Rules::take_action(g, legal[g.rng.below(legal.size())]);
+    }
+
+    GameStateSnapshot snap;
+    g.save(snap);
+    size_t steps_first = play_out(g);
+    uint64_t end_hash = g.hash();
+
+    g.restore(snap);
+    size_t steps_second = play_out(g);
+    EXPECT_EQ(steps_first, steps_second)
+        << "The rng is part of the snapshot, so the game must replay exactly.";
+    EXPECT_EQ(g.hash(), end_hash);
+}
+
+TEST(GameStateSnapshotTests, SnapshotCopiesWithMemcpy) {
+    GameState g;
+    g.reset(5);
+    GameStateSnapshot a, b;
+    g.save(a);
+    std::memcpy(&b, &a, sizeof(GameStateSnapshot));
+
+    GameState other;
+    other.restore(b);
+    EXPECT_EQ(other.hash(), g.hash());
+    EXPECT_EQ(other.num_players(), 5);
+    EXPECT_TRUE(cards_integrity_check(other.cards));
+}
+
+TEST(GameStateSnapshotTests, LazyDeckReplaysIdentically) {
+    GameState g;
+    g.seed(6);
+    g.cards.deck.set_lazy(true);
+    g.reset(3);
+
+    GameStateSnapshot snap;
+    g.save(snap);
+    size_t steps_first = play_out(g);
+    uint64_t end_hash = g.hash();
+
+    GameState other;
+    other.restore(snap);
+    EXPECT_TRUE(other.cards.deck.is_lazy());
+    EXPECT_EQ(play_out(other), steps_first)
+        << "Unresolved positions resolve the same way from the same rng.";
+    EXPECT_EQ(other.hash(), end_hash);
+}
+
+} // namespace exploding_kittens
\ No newline at end of file
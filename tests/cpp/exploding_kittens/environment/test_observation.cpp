@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include "testing_utils.h"
+
+#include "exploding_kittens/environment/observation.h"
+#include "exploding_kittens/environment/rules.h"
+#include "exploding_kittens/environment/vector_game_state.h"
+
+#include <array>
+#include <stdexcept>
+#include <vector>
+
+namespace exploding_kittens {
+
+using Observation = std::array<float, OBS_SIZE>;
+
+static Observation observe(GameState const &gs, uint8_t viewer) {
+    Observation obs;
+    encode_observation<float>(gs, viewer, obs);
+    return obs;
+}
+
+// Which card viewer knows at depth, or CardIdx::Error if none.
+static CardIdx known_at(Observation const &obs, size_t depth) {
+    for (uint8_t i = 0; i != UNIQUE_CARDS; ++i)
+        if (obs[OBS_KNOWN_TOP + depth * UNIQUE_CARDS + i] == 1)
+            return from_uint(i);
+    return CardIdx::Error;
+}
+
+TEST(ObservationTests, RelativeToViewer) {
+    GameState gs;
+    gs.seed(5);
+    gs.reset(3);
+    gs.cards.hands[2].place_at(gs.cards.discard_pile, CardIdx::Defuse);
+
+    Observation obs = observe(gs, 1);
+    for (uint8_t i = 0; i != UNIQUE_CARDS; ++i) {
+        EXPECT_EQ(obs[OBS_OWN_HAND + i], gs.cards.hands[1].has(i));
+        EXPECT_EQ(obs[OBS_DISCARD + i], gs.cards.discard_pile.has(i));
+    }
+    EXPECT_EQ(obs[OBS_HAND_SIZES + 0], CARDS_2_DEAL + 1) << "The viewer.";
+    EXPECT_EQ(obs[OBS_HAND_SIZES + 1], CARDS_2_DEAL) << "Player 2 is next.";
+    EXPECT_EQ(obs[OBS_HAND_SIZES + 2], CARDS_2_DEAL + 1) << "Player 0.";
+    EXPECT_EQ(obs[OBS_HAND_SIZES + 3], 0) << "No such player.";
+    EXPECT_EQ(obs[OBS_ALIVE + 2], 1);
+    EXPECT_EQ(obs[OBS_ALIVE + 3], 0);
+    EXPECT_EQ(obs[OBS_DECK_SIZE], gs.cards.deck.size());
+    EXPECT_EQ(obs[OBS_STATE + static_cast<size_t>(State::Default)], 1);
+    EXPECT_EQ(obs[OBS_TURNS_LEFT], 1);
+    EXPECT_EQ(obs[OBS_PRIMARY + 2], 1) << "Player 0 is two seats after 1.";
+    EXPECT_EQ(known_at(obs, 0), CardIdx::Error) << "Fresh deck is unknown.";
+
+    std::vector<float> wrong(OBS_SIZE + 1);
+    EXPECT_THROW(encode_observation<float>(gs, 1, wrong),
+        std::invalid_argument);
+    EXPECT_THROW(observe(gs, 3), std::invalid_argument);
+}
+
+TEST(ObservationTests, DefusePlacementOnlyKnownToPlacer) {
+    GameState gs;
+    defuse_state_reset(gs, 2, [](Cards &cards) {
+        cards.deck.counts()[to_uint(CardIdx::Cat_1)] = 5;
+        cards.hands[1].counts()[to_uint(CardIdx::Skip)] = 1;
+    });
+
+    Rules::take_action(gs, Action{ActionEnum::Play_Defuse, {}, 2, 0});
+    EXPECT_EQ(known_at(observe(gs, 0), 2), CardIdx::Exploding_Kitten);
+    EXPECT_EQ(known_at(observe(gs, 1), 2), CardIdx::Error)
+        << "Other players did not see where it went.";
+
+    Rules::take_action(gs, Action{ActionEnum::Draw, {}, 0, 0});
+    Observation obs = observe(gs, 0);
+    EXPECT_EQ(known_at(obs, 1), CardIdx::Exploding_Kitten)
+        << "A draw moves the known card up.";
+    EXPECT_EQ(known_at(obs, 2), CardIdx::Error);
+
+    gs.cards.deck.insert(CardIdx::Skip, 0);
+    EXPECT_EQ(known_at(observe(gs, 0), 2), CardIdx::Exploding_Kitten)
+        << "An insert above moves the known card down.";
+
+    gs.cards.deck.shuffle(gs.rng);
+    EXPECT_EQ(gs.cards.deck.known_mask(0), 0) << "Shuffling forgets.";
+}
+
+TEST(ObservationTests, BatchMatchesSingle) {
+    VectorGameState games(6, 4, 9);
+    std::vector<float> obs(games.size() * OBS_SIZE);
+    std::vector<uint8_t> bytes(games.size() * OBS_SIZE);
+    games.observations(obs);
+    games.observations(bytes);
+
+    for (size_t idx = 0; idx != games.size(); ++idx) {
+        Observation single = observe(games[idx], games.acting_players()[idx]);
+        for (size_t k = 0; k != OBS_SIZE; ++k) {
+            ASSERT_EQ(obs[idx * OBS_SIZE + k], single[k]);
+            ASSERT_EQ(bytes[idx * OBS_SIZE + k], single[k]);
+        }
+    }
+    EXPECT_THROW(games.observations(std::span<float>(obs).first(OBS_SIZE)),
+        std::invalid_argument);
+}
+
+} // namespace exploding_kittens
\ No newline at end of file
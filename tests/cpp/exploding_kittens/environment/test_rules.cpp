@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include "testing_utils.h"
+
+#include "exploding_kittens/environment/rules.h"
+#include "exploding_kittens/environment/actions/draw_card.h"
+#include "exploding_kittens/environment/actions/play_defuse.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace exploding_kittens {
+
+TEST(RulesTests, SameActionsAsActionTypes) {
+    GameState g;
+    DrawCard dc(g);
+    PlayDefuse pd(g);
+    g.seed(3);
+    g.reset(4);
+
+    ActionList rules_legal;
+    std::vector<Action> type_legal;
+    for (size_t step = 0; step != 200 and g.state != State::Game_Over; ++step) {
+        rules_legal.clear();
+        Rules::append_legal_actions(g, rules_legal);
+        type_legal = g.state == State::Default ?
+            get_legal_actions(dc) : get_legal_actions(pd);
+
+        ASSERT_EQ(rules_legal.size(), type_legal.size());
+        for (size_t idx = 0; idx != type_legal.size(); ++idx)
+            ASSERT_EQ(rules_legal[idx], type_legal[idx]);
+        Rules::take_action(g, rules_legal[g.rng.below(rules_legal.size())]);
+        ASSERT_TRUE(cards_integrity_check(g.cards));
+    }
+}
+
+TEST(RulesTests, OneRulesForManyGames) {
+    // No objects bound to the games: just plain states.
+    std::vector<GameState> games(3);
+    for (size_t idx = 0; idx != games.size(); ++idx) {
+        games[idx].seed(idx);
+        games[idx].reset(2 + idx);
+    }
+
+    ActionList legal;
+    for (GameState &g : games) {
+        size_t max_steps = 1000;
+        while (g.state != State::Game_Over) {
+            legal.clear();
+            Rules::append_legal_actions(g, legal);
+            ASSERT_FALSE(legal.empty());
+            Rules::take_action(g, legal[g.rng.below(legal.size())]);
+            ASSERT_NE(--max_steps, 0) << "Games should not take this long.";
+        }
+    }
+}
+
+TEST(RulesTests, UnimplementedActionsThrow) {
+    GameState g;
+    g.reset(2);
+    Action a{ActionEnum::Play_Attack, {}, 0, 0};
+    EXPECT_THROW(Rules::take_action(g, a), std::invalid_argument);
+    EXPECT_THROW(Rules::enforce_action(g, a), std::invalid_argument)
+        << "No static rules and nothing registered for this type.";
+}
+
+// Snapshot with zeroed padding and unused entries, so memcmp compares states:
+static GameStateSnapshot saved(GameState const &g) {
+    GameStateSnapshot snap;
+    std::memset(static_cast<void *>(&snap), 0, sizeof(snap));
+    g.save(snap);
+    return snap;
+}
+
+TEST(RulesTests, UndoRestoresExactly) {
+    for (bool lazy : {false, true}) {
+        GameState g;
+        g.seed(17);
+        g.cards.deck.set_lazy(lazy);
+        tabletop_general::Rng choices(5);
+        ActionList legal;
+        for (size_t game = 0; game != 10; ++game) {
+            g.reset(2 + game % 4);
+            std::vector<GameStateSnapshot> before;
+            std::vector<UndoRecord> undos;
+            while (g.state != State::Game_Over) {
+                legal.clear();
+                Rules::append_legal_actions(g, legal);
+                before.push_back(saved(g));
+                undos.push_back(Rules::make_action(g,
+                    legal[choices.below(legal.size())]));
+                ASSERT_EQ(g.hash(), g.full_hash());
+            }
+
+            // Taking everything back, and checking every state on the way:
+            while (not undos.empty()) {
+                Rules::undo_action(g, undos.back());
+                undos.pop_back();
+                GameStateSnapshot now = saved(g);
+                ASSERT_EQ(std::memcmp(&now, &before.back(), sizeof(now)), 0)
+                    << "Undoing should give back the exact state.";
+                ASSERT_EQ(g.hash(), g.full_hash());
+                before.pop_back();
+            }
+        }
+    }
+}
+
+TEST(RulesTests, MakeActionPlaysLikeTakeAction) {
+    GameState a, b;
+    a.seed(8);
+    b.seed(8);
+    a.reset(3);
+    b.reset(3);
+    ActionList legal;
+    while (a.state != State::Game_Over) {
+        legal.clear();
+        Rules::append_legal_actions(a, legal);
+        Action const &act = legal[legal.size() / 2];
+        Rules::take_action(a, act);
+        Rules::make_action(b, act);
+        ASSERT_EQ(a.hash(), b.hash()) << "Recording should not change a game.";
+    }
+    EXPECT_EQ(b.state, State::Game_Over);
+}
+
+} // namespace exploding_kittens
\ No newline at end of file
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include "testing_utils.h"
+
+#include "exploding_kittens/environment/vector_game_state.h"
+
+#include <vector>
+
+namespace exploding_kittens {
+
+TEST(VectorGameStateTests, InitChecks) {
+    VectorGameState vgs(16, 3);
+    ASSERT_EQ(vgs.size(), 16);
+    ASSERT_EQ(vgs.states().size(), 16);
+
+    for (size_t idx = 0; idx != vgs.size(); ++idx) {
+        EXPECT_EQ(vgs[idx].num_players(), 3)
+            << "Every game should have the specified number of players.";
+        EXPECT_TRUE(cards_integrity_check(vgs[idx].cards));
+        EXPECT_EQ(vgs.states()[idx], State::Default);
+        EXPECT_EQ(vgs.acting_players()[idx], 0) << "Player 0 always starts.";
+        EXPECT_EQ(vgs.turns_left()[idx], 1);
+    }
+    EXPECT_FALSE(vgs.all_done());
+
+    EXPECT_THROW(VectorGameState(4, 6), std::invalid_argument)
+        << "Invalid number of players should throw, like GameState::reset.";
+}
+
+TEST(VectorGameStateTests, StepWrongLength) {
+    VectorGameState vgs(4, 2);
+    std::vector<Action> actions(3);
+    EXPECT_THROW(vgs.step(actions), std::invalid_argument)
+        << "Need exactly one action per game.";
+}
+
+TEST(VectorGameStateTests, StepKeepsMirrorsInSync) {
+    VectorGameState vgs(8, 2);
+    std::vector<Action> actions(vgs.size());
+    ActionList legal;
+
+    vgs.append_legal_actions(0, legal);
+    ASSERT_EQ(legal.size(), 1) << "Only drawing is legal at the start.";
+    for (Action &a : actions)
+        a = legal[0];
+
+    vgs.step(actions);
+    for (size_t idx = 0; idx != vgs.size(); ++idx) {
+        EXPECT_EQ(vgs.states()[idx], vgs[idx].state);
+        EXPECT_EQ(vgs.acting_players()[idx], vgs[idx].acting_player());
+        EXPECT_EQ(vgs.turns_left()[idx], vgs[idx].turns_left);
+        EXPECT_EQ(col_sum(vgs[idx].cards.hands[0]), 9)
+            << "Player 0 of every game should have drawn a card.";
+    }
+}
+
+TEST(VectorGameStateTests, PlayAllGamesToTheEnd) {
+    VectorGameState vgs(32, 4);
+    std::vector<Action> actions(vgs.size());
+    ActionList legal;
+
+    size_t max_steps = 1000;
+    while (not vgs.all_done()) {
+        for (size_t idx = 0; idx != vgs.size(); ++idx) {
+            legal.clear();
+            vgs.append_legal_actions(idx, legal);
+            if (vgs.states()[idx] == State::Game_Over) {
+                ASSERT_EQ(legal.size(), 0) << "No actions after game over.";
+                continue;
+            }
+            ASSERT_GT(legal.size(), 0) << "Running games always have actions.";
+            actions[idx] = legal.back();
+        }
+        vgs.step(actions);
+        ASSERT_NE(--max_steps, 0) << "Games should not take this long.";
+    }
+
+    for (size_t idx = 0; idx != vgs.size(); ++idx) {
+        GameState &g = vgs[idx];
+        EXPECT_TRUE(cards_integrity_check(g.cards));
+        size_t alive = 0;
+        for (uint8_t player = 0; player != g.num_players(); ++player)
+            alive += g.is_alive(player);
+        EXPECT_EQ(alive, 1) << "Exactly one player should survive each game.";
+    }
+
+    vgs.reset(3);
+    EXPECT_EQ(vgs.states()[3], State::Default) << "Reset game should restart.";
+    EXPECT_FALSE(vgs.all_done());
+}
+
+} // namespace exploding_kittens
\ No newline at end of file
@@ -24,6 +24,24 @@ void custom_state_reset(GameState &gs, size_t num_player,
     // Set the deck and discard pile to a valid state:
     gs.cards.deck.ordered_from_data();
     gs.cards.discard_pile.ordered_from_data();
+    gs.rehash();
+}
+
+void defuse_state_reset(GameState &gs, size_t num_player,
+                        void (*card_spec_func)(Cards &)) {
+    custom_state_reset(gs, num_player, card_spec_func);
+    CardHand &hand = gs.cards.hands[0];
+    ++hand.counts()[to_uint(CardIdx::Exploding_Kitten)];
+    ++hand.counts()[to_uint(CardIdx::Defuse)];
+    hand.rehash();
+    gs.state = State::Defuse;
+}
+
+void kitten_parity_reset(GameState &gs) {
+    defuse_state_reset(gs, 2, [](Cards &c) {
+        c.hands[1].counts()[to_uint(CardIdx::Cat_1)] = 2U;
+        c.deck.counts()[to_uint(CardIdx::Cat_2)] = 5U;
+    });
 }
 
 std::array<size_t, UNIQUE_CARDS> row_sums(Cards &cards) {
@@ -16,6 +16,16 @@ namespace exploding_kittens {
 void custom_state_reset(GameState &gs, size_t num_player,
                                         void (*card_spec_func)(Cards &));
 
+// Like custom_state_reset, but player 0 also holds an exploding kitten and a
+// defuse, and has to place the kitten back: the game is in the Defuse state.
+void defuse_state_reset(GameState &gs, size_t num_player,
+                        void (*card_spec_func)(Cards &));
+
+// A 2 player defuse_state_reset where only the depth's parity matters: player
+// 1 has no defuse, and the deck five Cat_2's. An even depth (counted from the
+// top) makes player 1 draw the kitten.
+void kitten_parity_reset(GameState &gs);
+
 // Sum over all the rows: get total count for each type of card.
 std::array<size_t, UNIQUE_CARDS> row_sums(Cards &cards);
 
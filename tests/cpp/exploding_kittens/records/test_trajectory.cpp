@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+
+#include "exploding_kittens/records/trajectory.h"
+#include "exploding_kittens/environment/rules.h"
+
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace exploding_kittens {
+
+// Plays a random game, recording it and the hash after every action.
+static GameRecord play_recorded(GameState &gs, uint64_t seed,
+                                size_t num_players,
+                                std::vector<uint64_t> &hashes) {
+    gs.seed(seed);
+    gs.reset(num_players);
+    GameRecord record = GameRecord::start(gs);
+    hashes.assign(1, gs.hash());
+
+    ActionList legal;
+    while (gs.state != State::Game_Over) {
+        legal.clear();
+        Rules::append_legal_actions(gs, legal);
+        Action a = legal[gs.rng.below(legal.size())];
+        Rules::take_action(gs, a);
+        record.record(a);
+        hashes.push_back(gs.hash());
+    }
+    return record;
+}
+
+TEST(TrajectoryTests, ReplayReproducesEveryState) {
+    GameState gs;
+    std::vector<uint64_t> hashes;
+    GameRecord record = play_recorded(gs, 3, 3, hashes);
+
+    GameState replayed;
+    for (size_t k = 0; k != hashes.size(); ++k) {
+        record.replay(replayed, k);
+        ASSERT_EQ(replayed.hash(), hashes[k]) << "After " << k << " actions.";
+    }
+    EXPECT_EQ(replayed.state, State::Game_Over);
+    EXPECT_THROW(record.replay(replayed, hashes.size()), std::out_of_range);
+
+    gs.reset(3);
+    Rules::take_action(gs, Action{ActionEnum::Draw, {}, 0, 0});
+    EXPECT_THROW(GameRecord::start(gs), std::invalid_argument)
+        << "Games can only be recorded from the start.";
+}
+
+TEST(TrajectoryTests, BinaryRoundTrip) {
+    GameState gs;
+    std::vector<uint64_t> hashes;
+    std::vector<GameRecord> records;
+    for (uint64_t seed = 0; seed != 10; ++seed)
+        records.push_back(play_recorded(gs, seed, 2 + seed % 4, hashes));
+
+    std::stringstream stream;
+    TrajectoryWriter writer(stream);
+    size_t actions = 0;
+    for (GameRecord const &record : records) {
+        writer.write(record);
+        actions += record.actions.size();
+    }
+    EXPECT_LT(stream.str().size(), records.size() * 120 + 2 * actions)
+        << "Records should be compact.";
+
+    TrajectoryReader reader(stream);
+    GameRecord read;
+    for (GameRecord const &record : records) {
+        ASSERT_TRUE(reader.read(read));
+        EXPECT_EQ(read, record);
+    }
+    EXPECT_FALSE(reader.read(read)) << "Clean end of stream.";
+}
+
+TEST(TrajectoryTests, RejectsBadInput) {
+    std::stringstream not_ours("JUNKJUNK");
+    EXPECT_THROW(TrajectoryReader{not_ours}, std::runtime_error);
+
+    GameState gs;
+    std::vector<uint64_t> hashes;
+    std::stringstream stream;
+    TrajectoryWriter(stream).write(play_recorded(gs, 1, 2, hashes));
+    std::string bytes = stream.str();
+
+    std::stringstream truncated(bytes.substr(0, bytes.size() - 1));
+    TrajectoryReader reader(truncated);
+    GameRecord record;
+    EXPECT_THROW(reader.read(record), std::runtime_error);
+}
+
+TEST(TrajectoryTests, RejectsInvalidRecords) {
+    GameState gs;
+    std::vector<uint64_t> hashes;
+    GameRecord good = play_recorded(gs, 4, 2, hashes);
+
+    auto read_back = [](GameRecord const &record) {
+        std::stringstream stream;
+        TrajectoryWriter(stream).write(record);
+        GameRecord read;
+        TrajectoryReader(stream).read(read);
+        return read;
+    };
+    EXPECT_EQ(read_back(good), good);
+
+    // Deals that are not of a new game:
+    GameRecord bad = good;
+    bad.deck.back() = bad.deck.back() == CardIdx::Defuse ?
+        CardIdx::Skip : CardIdx::Defuse;
+    EXPECT_THROW(read_back(bad), std::runtime_error) << "Card swapped.";
+    bad = good;
+    bad.hands[1][to_uint(CardIdx::Cat_1)] = 40;
+    EXPECT_THROW(read_back(bad), std::runtime_error) << "Count too large.";
+
+    // An illegal action: no Nope at the start of a turn.
+    bad = good;
+    bad.actions.front() =
+        encode_action(Action{ActionEnum::Play_Nope, {}, 0, 0});
+    GameState replayed;
+    EXPECT_THROW(bad.replay(replayed), std::runtime_error);
+
+    // Nothing gets written for a record that does not fit the format:
+    bad = good;
+    bad.actions.resize(UINT16_MAX + 1, good.actions.front());
+    std::stringstream stream;
+    TrajectoryWriter writer(stream);
+    size_t header = stream.str().size();
+    EXPECT_THROW(writer.write(bad), std::runtime_error);
+    EXPECT_EQ(stream.str().size(), header);
+}
+
+} // namespace exploding_kittens
\ No newline at end of file
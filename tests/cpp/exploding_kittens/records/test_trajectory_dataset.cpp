@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+
+#include "exploding_kittens/records/trajectory_dataset.h"
+#include "exploding_kittens/environment/rules.h"
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+namespace exploding_kittens {
+
+namespace fs = std::filesystem;
+
+// Writes num_games random games to a file, returns the records.
+static std::vector<GameRecord> write_games(fs::path const &path,
+                                           size_t num_games) {
+    std::vector<GameRecord> records;
+    std::ofstream out(path, std::ios::binary);
+    TrajectoryWriter writer(out);
+    GameState gs;
+    ActionList legal;
+    for (size_t game = 0; game != num_games; ++game) {
+        gs.seed(game);
+        gs.reset(2 + game % 3);
+        GameRecord record = GameRecord::start(gs);
+        while (gs.state != State::Game_Over) {
+            legal.clear();
+            Rules::append_legal_actions(gs, legal);
+            Action a = legal[gs.rng.below(legal.size())];
+            Rules::take_action(gs, a);
+            record.record(a);
+        }
+        writer.write(record);
+        records.push_back(record);
+    }
+    return records;
+}
+
+TEST(TrajectoryDatasetTests, IndexesAndDecodesSamples) {
+    fs::path path = fs::temp_directory_path() / "ek_dataset_test.ektr";
+    std::vector<GameRecord> records = write_games(path, 20);
+
+    TrajectoryDataset dataset(path.string());
+    ASSERT_EQ(dataset.num_games(), records.size());
+    size_t total = 0;
+    for (GameRecord const &r : records)
+        total += r.actions.size();
+    ASSERT_EQ(dataset.num_samples(), total);
+
+    GameRecord record;
+    dataset.read_game(7, record);
+    EXPECT_EQ(record, records[7]);
+
+    // The samples of game 1 follow those of game 0:
+    size_t idx = records[0].actions.size() + 2;
+    GameState gs, expected;
+    std::vector<float> obs(OBS_SIZE), expected_obs(OBS_SIZE);
+    ActionCode action;
+    float ret = dataset.decode_sample(idx, record, gs, obs, action);
+
+    records[1].replay(expected, 2);
+    uint8_t player = expected.acting_player();
+    encode_observation<float>(expected, player, expected_obs);
+    EXPECT_EQ(obs, expected_obs);
+    EXPECT_EQ(action, records[1].actions[2]);
+    records[1].replay(expected);
+    EXPECT_EQ(ret, expected.winner() == player ? 1.0f : -1.0f);
+
+    // The same index from an index file:
+    fs::path index_path = path;
+    index_path += ".idx";
+    dataset.save_index(index_path.string());
+    TrajectoryDataset indexed(path.string(), index_path.string());
+    EXPECT_EQ(indexed.num_samples(), total);
+    indexed.read_game(19, record);
+    EXPECT_EQ(record, records[19]);
+
+    write_games(path, 3);   // Another file: the index no longer matches.
+    EXPECT_THROW(TrajectoryDataset(path.string(), index_path.string()),
+        std::runtime_error);
+    fs::remove(path);
+    fs::remove(index_path);
+    EXPECT_THROW(TrajectoryDataset(path.string()), std::runtime_error);
+}
+
+TEST(TrajectoryDatasetTests, SamplerIndependentOfThreads) {
+    fs::path path = fs::temp_directory_path() / "ek_sampler_test.ektr";
+    write_games(path, 10);
+    TrajectoryDataset dataset(path.string());
+
+    constexpr size_t batch = 37;
+    auto draw = [&](size_t num_threads) {
+        DatasetSampler sampler(dataset, num_threads, 5);
+        std::vector<float> obs(batch * OBS_SIZE), returns(batch);
+        std::vector<ActionCode> actions(batch);
+        sampler.sample(obs, actions, returns);
+        sampler.sample(obs, actions, returns);  // The second batch.
+        for (float r : returns)
+            EXPECT_TRUE(r == 1.0f or r == -1.0f);
+        return std::make_tuple(obs, actions, returns);
+    };
+    EXPECT_EQ(draw(1), draw(4));
+
+    DatasetSampler sampler(dataset, 2);
+    std::vector<float> obs(OBS_SIZE), returns(2);
+    std::vector<ActionCode> actions(2);
+    EXPECT_THROW(sampler.sample(obs, actions, returns),
+        std::invalid_argument);
+    fs::remove(path);
+}
+
+TEST(TrajectoryDatasetTests, ScanReplaysEveryRecord) {
+    fs::path path = fs::temp_directory_path() / "ek_scan_test.ektr";
+    std::vector<GameRecord> records = write_games(path, 2);
+
+    auto write_with = [&](GameRecord const &bad) {
+        std::ofstream out(path, std::ios::binary);
+        TrajectoryWriter writer(out);
+        writer.write(records[0]);
+        writer.write(bad);
+    };
+
+    GameRecord illegal = records[1];    // No Nope at the start of a turn:
+    illegal.actions.front() =
+        encode_action(Action{ActionEnum::Play_Nope, {}, 0, 0});
+    write_with(illegal);
+    EXPECT_THROW(TrajectoryDataset(path.string()), std::runtime_error);
+
+    GameRecord unfinished = records[1];
+    unfinished.actions.pop_back();
+    write_with(unfinished);
+    EXPECT_THROW(TrajectoryDataset(path.string()), std::runtime_error);
+
+    write_with(records[1]);
+    EXPECT_NO_THROW(TrajectoryDataset(path.string()));
+    fs::remove(path);
+}
+
+TEST(TrajectoryDatasetTests, IndexWithTooManySamples) {
+    fs::path path = fs::temp_directory_path() / "ek_bad_index_test.ektr";
+    fs::path index_path = path;
+    index_path += ".idx";
+    write_games(path, 2);
+    TrajectoryDataset(path.string()).save_index(index_path.string());
+
+    // The index ends with the number of actions of the last game:
+    {
+        std::fstream index(index_path, std::ios::in | std::ios::out |
+                                       std::ios::binary);
+        index.seekp(-2, std::ios::end);
+        index.put(static_cast<char>(0xff));
+    }
+    TrajectoryDataset indexed(path.string(), index_path.string());
+    GameRecord record;
+    GameState gs;
+    std::vector<float> obs(OBS_SIZE);
+    ActionCode action;
+    EXPECT_THROW(indexed.decode_sample(indexed.num_samples() - 1, record, gs,
+        obs, action), std::runtime_error);
+    fs::remove(path);
+    fs::remove(index_path);
+}
+
+} // namespace exploding_kittens
\ No newline at end of file
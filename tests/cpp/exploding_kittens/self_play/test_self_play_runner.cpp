@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include "exploding_kittens/self_play/game_scheduler.h"
+#include "exploding_kittens/self_play/self_play_runner.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace exploding_kittens {
+
+TEST(GameSchedulerTests, SingleWorkerGetsAll) {
+    GameScheduler scheduler(10, 1);
+    for (size_t i = 0; i != 10; ++i)
+        ASSERT_TRUE(scheduler.acquire(0)) << "10 games to hand out.";
+    EXPECT_FALSE(scheduler.acquire(0)) << "No games left.";
+    EXPECT_EQ(scheduler.remaining(), 0);
+
+    EXPECT_THROW(GameScheduler(10, 0), std::invalid_argument)
+        << "Zero workers is not allowed.";
+}
+
+TEST(GameSchedulerTests, WorkerStealsWhenOwnQueueEmpty) {
+    GameScheduler scheduler(9, 3);
+    size_t taken = 0;
+    while (scheduler.acquire(0))    // Worker 0 steals everything eventually.
+        ++taken;
+    EXPECT_EQ(taken, 9) << "Worker 0 should have stolen all other games.";
+    EXPECT_FALSE(scheduler.acquire(1));
+    EXPECT_FALSE(scheduler.acquire(2));
+}
+
+TEST(GameSchedulerTests, ConcurrentAcquireHandsOutEachGameOnce) {
+    GameScheduler scheduler(10000, 4);
+    std::atomic<size_t> taken = 0;
+    {
+        std::vector<std::jthread> threads;
+        for (size_t w = 0; w != 4; ++w)
+            threads.emplace_back([&, w]() {
+                while (scheduler.acquire(w))
+                    ++taken;
+            });
+    }
+    EXPECT_EQ(taken, 10000) << "Every game handed out exactly once.";
+}
+
+TEST(SelfPlayRunnerTests, PlaysAllGames) {
+    for (size_t threads = 1; threads <= 3; ++threads) {
+        SelfPlayConfig config;
+        config.num_games = 250;
+        config.num_threads = threads;
+        config.num_players = 3;
+        config.envs_per_thread = 16;
+
+        SelfPlayStats stats = run_self_play(config);
+        EXPECT_EQ(stats.games, 250) << "All games should get played.";
+        EXPECT_GE(stats.steps, stats.games) << "A game has at least 1 step.";
+
+        size_t wins = 0;
+        for (size_t w : stats.wins)
+            wins += w;
+        EXPECT_EQ(wins, 250) << "Every game has exactly one winner.";
+        EXPECT_EQ(stats.wins[3] + stats.wins[4], 0) << "Only 3 seats.";
+    }
+}
+
+TEST(SelfPlayRunnerTests, InvalidConfigThrows) {
+    SelfPlayConfig config;
+    config.num_threads = 0;
+    EXPECT_THROW(run_self_play(config), std::invalid_argument);
+    config.num_threads = 1;
+    config.num_players = 6;
+    EXPECT_THROW(run_self_play(config), std::invalid_argument);
+}
+
+} // namespace exploding_kittens
\ No newline at end of file
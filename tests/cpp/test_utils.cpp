@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+
+#include "utils.h"
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include <vector>
+
+namespace tabletop_general {
+
+TEST(RngTests, SameSeedSameStream) {
+    Rng a(42), b(42), c(43);
+    bool any_diff = false;
+    for (size_t i = 0; i != 100; ++i) {
+        uint64_t va = a();
+        EXPECT_EQ(va, b()) << "Same seed must give the same numbers.";
+        any_diff |= va != c();
+    }
+    EXPECT_TRUE(any_diff) << "Different seeds should give different numbers.";
+}
+
+TEST(RngTests, CounterJumps) {
+    Rng a(7);
+    std::vector<uint64_t> first;
+    for (size_t i = 0; i != 10; ++i)
+        first.push_back(a());
+    EXPECT_EQ(a.counter(), 10);
+
+    Rng b(7);
+    b.set_counter(5);
+    for (size_t i = 5; i != 10; ++i)
+        EXPECT_EQ(b(), first[i]) << "Jumping must land on the same output.";
+}
+
+TEST(RngTests, SplitStreamsDiffer) {
+    Rng base(1);
+    Rng s0 = base.split(0), s1 = base.split(1), s0_again = base.split(0);
+    EXPECT_EQ(base.counter(), 0) << "split should not advance the parent.";
+    uint64_t v0 = s0();
+    EXPECT_EQ(v0, s0_again()) << "Same stream index gives the same stream.";
+    EXPECT_NE(v0, s1()) << "Different streams should differ.";
+}
+
+TEST(RngTests, BelowIsInRangeAndRoughlyUniform) {
+    Rng rng(1996);
+    std::array<size_t, 7> hist{};
+    for (size_t i = 0; i != 70000; ++i) {
+        uint64_t v = rng.below(7);
+        ASSERT_LT(v, 7);
+        ++hist[v];
+    }
+    for (size_t count : hist) {
+        EXPECT_GT(count, 9400) << "Each bucket should get about 10000.";
+        EXPECT_LT(count, 10600) << "Each bucket should get about 10000.";
+    }
+    EXPECT_EQ(rng.below(1), 0);
+}
+
+TEST(RngTests, WorksWithStdShuffle) {
+    Rng rng(3);
+    std::vector<int> v(20);
+    std::iota(v.begin(), v.end(), 0);
+    std::shuffle(v.begin(), v.end(), rng);
+    std::vector<int> sorted = v;
+    std::sort(sorted.begin(), sorted.end());
+    for (int i = 0; i != 20; ++i)
+        EXPECT_EQ(sorted[i], i) << "Shuffling must be a permutation.";
+}
+
+} // namespace tabletop_general
\ No newline at end of file